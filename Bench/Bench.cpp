@@ -0,0 +1,126 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    std::atomic<size_t> g_AllocCount{ 0 };
+    std::atomic<size_t> g_AllocBytes{ 0 };
+    std::atomic<size_t> g_LiveBytes{ 0 };
+    std::chrono::nanoseconds g_MinTime = std::chrono::milliseconds(20);
+
+    struct Registered
+    {
+        std::string_view m_Name;
+        Bench::BenchFn m_Fn;
+    };
+    std::vector<Registered>& registry()
+    {
+        static std::vector<Registered> benches;
+        return benches;
+    }
+
+    // each allocation is preceded by its size, so that frees can be subtracted from the live total.  16 bytes keeps the alignment malloc gives
+    constexpr size_t allocHeader = 16;
+
+    void* countedAlloc(size_t count)
+    {
+        g_AllocCount.fetch_add(1, std::memory_order_relaxed);
+        g_AllocBytes.fetch_add(count, std::memory_order_relaxed);
+        g_LiveBytes.fetch_add(count, std::memory_order_relaxed);
+        if (auto p = static_cast<char*>(std::malloc(count + allocHeader)))
+        {
+            memcpy(p, &count, sizeof(count));
+            return p + allocHeader;
+        }
+        throw std::bad_alloc();
+    }
+
+    void countedFree(void* p) noexcept
+    {
+        if (!p)
+            return;
+        auto pAlloc = static_cast<char*>(p) - allocHeader;
+        size_t count = 0;
+        memcpy(&count, pAlloc, sizeof(count));
+        g_LiveBytes.fetch_sub(count, std::memory_order_relaxed);
+        std::free(pAlloc);
+    }
+}
+
+void* operator new(size_t count) { return countedAlloc(count); }
+void* operator new[](size_t count) { return countedAlloc(count); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t) noexcept { countedFree(p); }
+
+Bench::AllocStats Bench::allocStats() noexcept
+{
+    return { g_AllocCount.load(std::memory_order_relaxed), g_AllocBytes.load(std::memory_order_relaxed), g_LiveBytes.load(std::memory_order_relaxed) };
+}
+
+std::chrono::nanoseconds Bench::minTime() noexcept
+{
+    return g_MinTime;
+}
+
+void Bench::report(std::string_view name, std::string_view variant, size_t len, const Result& result, size_t bytesPerObj)
+{
+    char bytes[32] = "";
+    if (bytesPerObj != 0)
+        std::snprintf(bytes, sizeof(bytes), "%zu", bytesPerObj);
+    std::printf("%-28.*s %-16.*s %8zu %12.2f %10.3f %10s\n",
+        static_cast<int>(name.size()), name.data(),
+        static_cast<int>(variant.size()), variant.data(),
+        len, result.m_NsPerOp, result.m_AllocsPerOp, bytes);
+    std::fflush(stdout);
+}
+
+Bench::Registrar::Registrar(const char* name, BenchFn fn)
+{
+    registry().push_back({ name, fn });
+}
+
+int Bench::runAllBenchmarks(const std::vector<std::string_view>& args)
+{
+    constexpr std::string_view minTimeOpt = "--min-time-ms=";
+    std::vector<std::string_view> filters;
+    for (size_t i = 1; i < args.size(); ++i)
+    {
+        const auto arg = args[i];
+        if (arg.starts_with(minTimeOpt))
+        {
+            unsigned ms = 0;
+            std::from_chars(arg.data() + minTimeOpt.size(), arg.data() + arg.size(), ms);
+            g_MinTime = std::chrono::milliseconds(ms);
+        }
+        else
+        {
+            filters.push_back(arg);
+        }
+    }
+
+    std::printf("%-28s %-16s %8s %12s %10s %10s\n", "benchmark", "variant", "len", "ns/op", "allocs/op", "bytes/obj");
+    for (const auto& bench : registry())
+    {
+        const auto selected = filters.empty() || std::any_of(filters.begin(), filters.end(),
+            [&bench](std::string_view filter) { return bench.m_Name.find(filter) != std::string_view::npos; });
+        if (selected)
+            bench.m_Fn();
+    }
+    return 0;
+}
+
+int main(int argc, const char* argv[])
+{
+    return Bench::runAllBenchmarks(std::vector<std::string_view>(argv, argv + argc));
+}
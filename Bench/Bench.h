@@ -0,0 +1,118 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+Minimal micro benchmark harness.
+Benchmarks register themselves with BENCH(Name) (in the same way that tests register with TEST(Name)) and report one line per measurement.
+Allocation counts come from the replacement global operator new in Bench.cpp, so allocations made by std::string and SString8 are both seen.
+*/
+namespace Bench
+{
+    /** Running totals of calls to the global operator new since program start, and the bytes currently allocated */
+    struct AllocStats
+    {
+        size_t m_Count = 0;
+        size_t m_Bytes = 0;
+        size_t m_LiveBytes = 0;
+    };
+    AllocStats allocStats() noexcept;
+
+    struct Result
+    {
+        double m_NsPerOp = 0.0;
+        double m_AllocsPerOp = 0.0;
+    };
+
+    /** Minimum wall time spent on a single measurement, settable from the command line with --min-time-ms=N */
+    std::chrono::nanoseconds minTime() noexcept;
+
+    /** Stop the optimiser from discarding a value, or from assuming that it is unchanged */
+    template<class T>
+    inline void doNotOptimize(const T& value)
+    {
+#if defined(_MSC_VER)
+        const volatile void* p = &value;
+        (void)p;
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "g"(&value) : "memory");
+#endif
+    }
+
+    /**
+    Repeatedly call fn(iterations), doubling iterations until a single call takes at least minTime().
+    fn must perform exactly iterations operations.
+    */
+    template<class Fn>
+    Result measure(Fn&& fn)
+    {
+        using clock = std::chrono::steady_clock;
+        const auto target = minTime();
+        size_t iterations = 1;
+        for (;;)
+        {
+            const auto allocsBefore = allocStats();
+            const auto start = clock::now();
+            fn(iterations);
+            const auto elapsed = clock::now() - start;
+            const auto allocsAfter = allocStats();
+            if (elapsed >= target || iterations >= (size_t(1) << 40U))
+            {
+                const auto ns = std::chrono::duration<double, std::nano>(elapsed).count();
+                const auto its = static_cast<double>(iterations);
+                return { ns / its, static_cast<double>(allocsAfter.m_Count - allocsBefore.m_Count) / its };
+            }
+            iterations *= 2;
+        }
+    }
+
+    /** Time one call of fn(), which performs ops operations.  For operations that are too expensive to repeat, eg sorting millions of strings */
+    template<class Fn>
+    Result measureOnce(size_t ops, Fn&& fn)
+    {
+        using clock = std::chrono::steady_clock;
+        const auto allocsBefore = allocStats();
+        const auto start = clock::now();
+        fn();
+        const auto elapsed = clock::now() - start;
+        const auto allocsAfter = allocStats();
+        const auto ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        const auto dOps = static_cast<double>(ops);
+        return { ns / dOps, static_cast<double>(allocsAfter.m_Count - allocsBefore.m_Count) / dOps };
+    }
+
+    /** Heap bytes requested by make(), plus sizeof the object it returns.  Allocator overhead is not included. */
+    template<class Make>
+    size_t bytesPerObject(Make&& make)
+    {
+        const auto before = allocStats();
+        const auto obj = make();
+        const auto after = allocStats();
+        return sizeof(obj) + (after.m_Bytes - before.m_Bytes);
+    }
+
+    /** Print one line of results.  bytesPerObj of 0 leaves the column blank */
+    void report(std::string_view name, std::string_view variant, size_t len, const Result& result, size_t bytesPerObj = 0);
+
+    using BenchFn = void(*)();
+    struct Registrar
+    {
+        Registrar(const char* name, BenchFn fn);
+    };
+
+    /** Run every registered benchmark whose name contains one of the non-option arguments (or all of them if there are none) */
+    int runAllBenchmarks(const std::vector<std::string_view>& args);
+}
+
+#define BENCH(Name) \
+    static void Name(); \
+    static const Bench::Registrar Name##_registrar(#Name, &Name); \
+    static void Name()
@@ -0,0 +1,350 @@
+#include "SString8.h"
+
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /** Lengths either side of each tier boundary: buffer/small (7/8), small/medium (254/255) and medium/large (2^15) */
+    constexpr size_t tierLengths[] = { 0, 7, 8, 32, 254, 255, 1024, (1U << 15U) - 1U, 1U << 15U };
+
+    template<class StringType>
+    constexpr std::string_view typeName()
+    {
+        if constexpr (std::is_same_v<StringType, SString8>)
+            return "SString8";
+        else
+            return "std::string";
+    }
+
+    std::string makeText(size_t len, char last = 'z')
+    {
+        std::string text(len, 'a');
+        if (len != 0)
+            text.back() = last;
+        return text;
+    }
+
+    template<class StringType>
+    void benchConstruct(size_t len)
+    {
+        const auto text = makeText(len);
+        const std::string_view src(text);
+        const auto result = Bench::measure([src](size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    StringType str(src);
+                    Bench::doNotOptimize(str);
+                }
+            });
+        Bench::report("construct(string_view)", typeName<StringType>(), len, result, Bench::bytesPerObject([src]() { return StringType(src); }));
+
+        const std::vector<char> chars(text.begin(), text.end());
+        const auto rangeResult = Bench::measure([&chars](size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    StringType str(chars.begin(), chars.end());
+                    Bench::doNotOptimize(str);
+                }
+            });
+        Bench::report("construct(first, last)", typeName<StringType>(), len, rangeResult);
+    }
+
+    template<class StringType>
+    void benchCopy(size_t len)
+    {
+        const StringType src(makeText(len));
+        const auto result = Bench::measure([&src](size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    StringType str(src);
+                    Bench::doNotOptimize(str);
+                }
+            });
+        Bench::report("copy construct", typeName<StringType>(), len, result, Bench::bytesPerObject([&src]() { return StringType(src); }));
+    }
+
+    template<class StringType>
+    void benchMove(size_t len)
+    {
+        StringType src(makeText(len));
+        const auto result = Bench::measure([&src](size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    StringType str(std::move(src));
+                    Bench::doNotOptimize(str);
+                    src = std::move(str);
+                }
+            });
+        Bench::report("move construct+assign", typeName<StringType>(), len, result);
+    }
+
+    template<class StringType>
+    void benchAssign(size_t len)
+    {
+        const StringType src(makeText(len, 'y'));
+        StringType dst(makeText(len));
+        const auto result = Bench::measure([&src, &dst](size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    dst = src;
+                    Bench::doNotOptimize(dst);
+                }
+            });
+        Bench::report("copy assign", typeName<StringType>(), len, result);
+
+        const auto text = makeText(len, 'x');
+        const std::string_view sv(text);
+        const auto svResult = Bench::measure([sv, &dst](size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    dst = sv;
+                    Bench::doNotOptimize(dst);
+                }
+            });
+        Bench::report("assign(string_view)", typeName<StringType>(), len, svResult);
+
+        // a short field into a string of len chars, whose storage is kept (eg a reused vector of fields)
+        const std::string_view shortSv("abcde");
+        const auto shortResult = Bench::measure([shortSv, &dst, len](size_t n)
+            {
+                dst.reserve(len);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    dst = shortSv;
+                    Bench::doNotOptimize(dst);
+                }
+            });
+        Bench::report("assign(5 chars) into len", typeName<StringType>(), len, shortResult);
+    }
+
+    template<class StringType>
+    void benchReserve(size_t len)
+    {
+        const auto result = Bench::measure([len](size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    StringType str;
+                    str.reserve(len);
+                    Bench::doNotOptimize(str);
+                }
+            });
+        Bench::report("reserve", typeName<StringType>(), len, result);
+    }
+
+    template<class StringType>
+    void benchAccessors(size_t len)
+    {
+        const StringType str(makeText(len));
+        {
+            const auto result = Bench::measure([&str](size_t n)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Bench::doNotOptimize(str);
+                        const auto sz = str.size();
+                        Bench::doNotOptimize(sz);
+                    }
+                });
+            Bench::report("size()", typeName<StringType>(), len, result);
+        }
+        {
+            const auto result = Bench::measure([&str](size_t n)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Bench::doNotOptimize(str);
+                        const auto p = str.data();
+                        Bench::doNotOptimize(p);
+                    }
+                });
+            Bench::report("data()", typeName<StringType>(), len, result);
+        }
+        {
+            const auto result = Bench::measure([&str](size_t n)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Bench::doNotOptimize(str);
+                        const auto cap = str.capacity();
+                        Bench::doNotOptimize(cap);
+                    }
+                });
+            Bench::report("capacity()", typeName<StringType>(), len, result);
+        }
+        {
+            const auto result = Bench::measure([&str](size_t n)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Bench::doNotOptimize(str);
+                        const std::string_view sv(str.data(), str.size());
+                        Bench::doNotOptimize(sv);
+                    }
+                });
+            Bench::report("data()+size()", typeName<StringType>(), len, result);
+        }
+    }
+
+    template<class StringType>
+    void benchCompare(size_t len)
+    {
+        // equal contents in separate objects, so that the whole string has to be compared
+        const StringType lhs(makeText(len));
+        const StringType rhsEqual(makeText(len));
+        const StringType rhsLess(makeText(len, 'y'));
+        {
+            const auto result = Bench::measure([&lhs, &rhsEqual](size_t n)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Bench::doNotOptimize(lhs);
+                        const bool eq = lhs == rhsEqual;
+                        Bench::doNotOptimize(eq);
+                    }
+                });
+            Bench::report("operator==", typeName<StringType>(), len, result);
+        }
+        {
+            const auto result = Bench::measure([&lhs, &rhsLess](size_t n)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Bench::doNotOptimize(lhs);
+                        const bool less = (lhs <=> rhsLess) < 0;
+                        Bench::doNotOptimize(less);
+                    }
+                });
+            Bench::report("operator<=>", typeName<StringType>(), len, result);
+        }
+    }
+
+    /** Strings from every tier, interleaved so that the branch predictor can't learn the tier of the next string */
+    template<class StringType>
+    void benchMixedTierScan()
+    {
+        std::vector<StringType> strs;
+        uint32_t rnd = 12345U;
+        for (size_t i = 0; i < 1024; ++i)
+        {
+            rnd = rnd * 1664525U + 1013904223U; // LCG, good enough to defeat the branch predictor
+            strs.emplace_back(makeText(tierLengths[(rnd >> 16U) % std::size(tierLengths)]));
+        }
+        const auto result = Bench::measure([&strs](size_t n)
+            {
+                size_t total = 0;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    const auto& str = strs[i & 1023U];
+                    const std::string_view sv(str);
+                    total += sv.size() + static_cast<unsigned char>(sv.empty() ? 0 : sv.front());
+                }
+                Bench::doNotOptimize(total);
+            });
+        Bench::report("mixed tiers string_view()", typeName<StringType>(), 0, result);
+    }
+
+    /** Build a string of len chars one push_back at a time, starting from empty */
+    template<class StringType>
+    void benchPushBack(size_t len)
+    {
+        const auto result = Bench::measure([len](size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    StringType str;
+                    for (size_t j = 0; j < len; ++j)
+                        str.push_back('a');
+                    Bench::doNotOptimize(str);
+                }
+            });
+        Bench::report("push_back to len", typeName<StringType>(), len, result);
+    }
+
+    /** Build a string of len chars by appending 5 char pieces */
+    template<class StringType>
+    void benchAppend(size_t len)
+    {
+        const std::string_view piece("abcde");
+        const auto result = Bench::measure([len, piece](size_t n)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    StringType str;
+                    for (size_t j = 0; j < len; j += piece.size())
+                        str.append(piece);
+                    Bench::doNotOptimize(str);
+                }
+            });
+        Bench::report("append(5 chars) to len", typeName<StringType>(), len, result);
+    }
+
+    template<class Fn>
+    void forEachTierLength(Fn&& fn)
+    {
+        for (const auto len : tierLengths)
+            fn(len);
+    }
+}
+
+BENCH(BenchSString8Construct)
+{
+    forEachTierLength([](size_t len) { benchConstruct<SString8>(len); benchConstruct<std::string>(len); });
+}
+
+BENCH(BenchSString8Copy)
+{
+    forEachTierLength([](size_t len) { benchCopy<SString8>(len); benchCopy<std::string>(len); });
+}
+
+BENCH(BenchSString8Move)
+{
+    forEachTierLength([](size_t len) { benchMove<SString8>(len); benchMove<std::string>(len); });
+}
+
+BENCH(BenchSString8Assign)
+{
+    forEachTierLength([](size_t len) { benchAssign<SString8>(len); benchAssign<std::string>(len); });
+}
+
+BENCH(BenchSString8Reserve)
+{
+    forEachTierLength([](size_t len) { benchReserve<SString8>(len); benchReserve<std::string>(len); });
+}
+
+BENCH(BenchSString8Accessors)
+{
+    forEachTierLength([](size_t len) { benchAccessors<SString8>(len); benchAccessors<std::string>(len); });
+}
+
+BENCH(BenchSString8MixedTiers)
+{
+    benchMixedTierScan<SString8>();
+    benchMixedTierScan<std::string>();
+}
+
+BENCH(BenchSString8Compare)
+{
+    forEachTierLength([](size_t len) { benchCompare<SString8>(len); benchCompare<std::string>(len); });
+}
+
+BENCH(BenchSString8Append)
+{
+    forEachTierLength([](size_t len) { benchPushBack<SString8>(len); benchPushBack<std::string>(len); });
+    forEachTierLength([](size_t len) { benchAppend<SString8>(len); benchAppend<std::string>(len); });
+}
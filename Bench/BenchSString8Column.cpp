@@ -0,0 +1,66 @@
+#include "SString8Column.h"
+
+#include "Bench.h"
+
+#include <memory>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    constexpr size_t rowCount = 10'000'000;
+
+    /** A batch of short heap strings (12 to 27 chars), eg a column of user agent or URL path fragments */
+    std::vector<std::string> makeValues()
+    {
+        std::vector<std::string> values;
+        values.reserve(1024);
+        for (size_t i = 0; i < 1024; ++i)
+            values.push_back("value-" + std::string(6 + i % 16, static_cast<char>('a' + i % 26)));
+        return values;
+    }
+
+    /** Fill a column of rowCount strings, scan it (summing lengths and first chars), and tear it down, reporting each, with the heap bytes per string after filling */
+    template<class Column, class Append>
+    void benchColumn(std::string_view variant, const std::vector<std::string>& values, Append&& append)
+    {
+        const auto before = Bench::allocStats();
+        auto pColumn = std::make_unique<Column>();
+        auto& column = *pColumn;
+        const auto fillResult = Bench::measureOnce(rowCount, [&]()
+            {
+                for (size_t i = 0; i < rowCount; ++i)
+                    append(column, std::string_view(values[i & 1023U]));
+            });
+        const auto liveBytes = Bench::allocStats().m_LiveBytes - before.m_LiveBytes;
+        Bench::report("column append 10M", variant, 0, fillResult, liveBytes / rowCount);
+
+        const auto scanResult = Bench::measureOnce(rowCount, [&]()
+            {
+                size_t total = 0;
+                for (const auto& str : column)
+                {
+                    const std::string_view view(str);
+                    total += view.size() + static_cast<unsigned char>(view[0]);
+                }
+                Bench::doNotOptimize(total);
+            });
+        Bench::report("column scan 10M", variant, 0, scanResult);
+
+        const auto clearResult = Bench::measureOnce(rowCount, [&]()
+            {
+                pColumn.reset();
+            });
+        Bench::report("column teardown 10M", variant, 0, clearResult);
+    }
+}
+
+BENCH(BenchSString8Column)
+{
+    const auto values = makeValues();
+    benchColumn<SString8Column>("SString8Column", values, [](SString8Column& column, std::string_view str) { column.push_back(str); });
+    benchColumn<std::vector<SString8>>("vector<SString8>", values, [](std::vector<SString8>& column, std::string_view str) { column.emplace_back(str); });
+    benchColumn<std::vector<std::string>>("vector<string>", values, [](std::vector<std::string>& column, std::string_view str) { column.emplace_back(str); });
+}
@@ -0,0 +1,121 @@
+#include "SString8Delimited.h"
+#include "SString8Split.h"
+
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr size_t fileBytes = 256 * 1024 * 1024;
+
+    /** A reference dataset of rows of short fields (an id, a date, codes and small numbers), with a longer description in some rows.  Gives the number of rows */
+    size_t writeDataset(const std::filesystem::path& path, char delimiter)
+    {
+        const char* codes[] = { "GB", "FR", "DE", "US", "JP" };
+        std::ofstream os(path, std::ios::binary);
+        std::string row;
+        row = std::string("id") + delimiter + "date" + delimiter + "country" + delimiter + "qty" + delimiter + "price" + delimiter + "flag" + delimiter + "description\n";
+        os << row;
+        size_t written = row.size();
+        size_t rows = 0;
+        uint64_t seed = 0x853C49E6748FEA9BULL;
+        while (written < fileBytes)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            row = std::to_string(1000000 + rows);
+            row += delimiter;
+            row += "20261018";
+            row += delimiter;
+            row += codes[(seed >> 33U) % 5];
+            row += delimiter;
+            row += std::to_string((seed >> 20U) % 1000);
+            row += delimiter;
+            row += std::to_string((seed >> 40U) % 100) + "." + std::to_string((seed >> 50U) % 100);
+            row += delimiter;
+            row += ((seed >> 55U) % 2) ? "Y" : "N";
+            row += delimiter;
+            if ((seed >> 59U) == 0)
+                row += "a longer free text description";
+            row += '\n';
+            os << row;
+            written += row.size();
+            ++rows;
+        }
+        return rows;
+    }
+
+    void benchLoad(std::string_view name, char delimiter)
+    {
+        const auto path = std::filesystem::temp_directory_path() / "BenchSString8Delimited.txt";
+        const auto rows = writeDataset(path, delimiter);
+        std::vector<size_t> threadCounts = { 1 };
+        if (std::thread::hardware_concurrency() > 1)
+            threadCounts.push_back(std::thread::hardware_concurrency());
+
+        // the floor: one pass over the mapped bytes, counting the lines
+        const auto readResult = Bench::measureOnce(rows, [&]()
+            {
+                const SString8Detail::MappedFile file(path, SString8Detail::MappedFile::Access::READ_ONLY, "BenchSString8Delimited");
+                Bench::doNotOptimize(std::count(file.data(), file.data() + file.size(), '\n'));
+            });
+        Bench::report(name, "count lines of mapping", 0, readResult);
+
+        for (const auto longValues : { SString8LongValues::ARENA, SString8LongValues::BORROW_MAPPING })
+        {
+            for (const auto threadCount : threadCounts)
+            {
+                SString8DelimitedOptions options;
+                options.m_Delimiter = delimiter;
+                options.m_ThreadCount = threadCount;
+                options.m_LongValues = longValues;
+                const auto result = Bench::measureOnce(rows, [&]()
+                    {
+                        const SString8DelimitedTable table(path, options);
+                        Bench::doNotOptimize(table.rowCount());
+                    });
+                const auto variant = std::string((longValues == SString8LongValues::ARENA) ? "SString8DelimitedTable arena " : "SString8DelimitedTable borrow ")
+                    + std::to_string(threadCount) + ((threadCount == 1) ? " thread" : " threads");
+                Bench::report(name, variant, 0, result);
+            }
+        }
+
+        // what the loader replaces: getline, then each field copied into its column
+        const auto getlineResult = Bench::measureOnce(rows, [&]()
+            {
+                std::ifstream is(path, std::ios::binary);
+                std::string line;
+                std::getline(is, line);
+                std::vector<std::vector<SString8>> columns(7);
+                std::vector<SString8> fields;
+                while (std::getline(is, line))
+                {
+                    split_sstring8(line, delimiter, fields);
+                    for (size_t i = 0; i < fields.size() && i < columns.size(); ++i)
+                        columns[i].push_back(fields[i]);
+                }
+                Bench::doNotOptimize(columns);
+            });
+        Bench::report(name, "getline and split", 0, getlineResult);
+
+        std::filesystem::remove(path);
+    }
+}
+
+BENCH(BenchSString8DelimitedCsv)
+{
+    benchLoad("load 256MB csv (per row)", ',');
+}
+
+BENCH(BenchSString8DelimitedTsv)
+{
+    benchLoad("load 256MB tsv (per row)", '\t');
+}
@@ -0,0 +1,98 @@
+#include "SString8FlatMap.h"
+
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    /** count distinct keys of len chars, in a scattered order */
+    std::vector<std::string> makeKeys(size_t count, size_t len, char first)
+    {
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        uint64_t seed = 0x9E3779B97F4A7C15ULL;
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::string key(len, first);
+            auto n = i;
+            for (size_t j = 0; j < len && n != 0; ++j, n /= 26)
+                key[j] = static_cast<char>(first + n % 26);
+            keys.push_back(std::move(key));
+        }
+        for (size_t i = count; i > 1; --i)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            std::swap(keys[i - 1], keys[(seed >> 33U) % i]);
+        }
+        return keys;
+    }
+
+    /**
+    Build a map of every key, then look each one up (by string_view) and look up keys that aren't there.
+    Reports insert, hit and miss times, with the live heap bytes per entry (map plus keys) on the insert line.
+    */
+    template<class Map, class Insert, class Find>
+    void benchMap(std::string_view variant, const std::vector<std::string>& keys, const std::vector<std::string>& missing, Insert&& insert, Find&& find)
+    {
+        const auto len = keys.front().size();
+        const auto count = keys.size();
+        const auto millions = " " + std::to_string(count / 1'000'000) + "M";
+        const auto before = Bench::allocStats();
+        Map map;
+        const auto insertResult = Bench::measureOnce(count, [&]()
+            {
+                for (size_t i = 0; i < count; ++i)
+                    insert(map, keys[i], i);
+            });
+        const auto liveBytes = Bench::allocStats().m_LiveBytes - before.m_LiveBytes;
+        Bench::report("flat map insert" + millions, variant, len, insertResult, sizeof(map) / count + liveBytes / count);
+
+        const auto hitResult = Bench::measure([&](size_t n)
+            {
+                size_t total = 0;
+                for (size_t i = 0; i < n; ++i)
+                    total += find(map, std::string_view(keys[i % count]));
+                Bench::doNotOptimize(total);
+            });
+        Bench::report("flat map find hit" + millions, variant, len, hitResult);
+
+        const auto missResult = Bench::measure([&](size_t n)
+            {
+                size_t total = 0;
+                for (size_t i = 0; i < n; ++i)
+                    total += find(map, std::string_view(missing[i % missing.size()]));
+                Bench::doNotOptimize(total);
+            });
+        Bench::report("flat map find miss" + millions, variant, len, missResult);
+    }
+
+    void benchMaps(size_t count, size_t len)
+    {
+        const auto keys = makeKeys(count, len, 'a');
+        const auto missing = makeKeys(count < 100'000 ? count : 100'000, len, 'A');
+        benchMap<SString8FlatMap<size_t>>("SString8FlatMap", keys, missing,
+            [](auto& map, const std::string& key, size_t i) { map.try_emplace(std::string_view(key), i); },
+            [](const auto& map, std::string_view key) -> size_t { const auto it = map.find(key); return (it == map.end()) ? 0 : it->second; });
+        benchMap<std::unordered_map<SString8, size_t, SString8Hash, SString8Equal>>("unordered_map<S8>", keys, missing,
+            [](auto& map, const std::string& key, size_t i) { map.try_emplace(SString8(key), i); },
+            [](const auto& map, std::string_view key) -> size_t { const auto it = map.find(key); return (it == map.end()) ? 0 : it->second; });
+        benchMap<std::unordered_map<std::string, size_t>>("unordered_map", keys, missing,
+            [](auto& map, const std::string& key, size_t i) { map.try_emplace(key, i); },
+            [](const auto& map, std::string_view key) -> size_t { const auto it = map.find(std::string(key)); return (it == map.end()) ? 0 : it->second; });
+    }
+}
+
+BENCH(BenchSString8FlatMap)
+{
+    for (const auto count : { 1'000'000U, 10'000'000U })
+    {
+        benchMaps(count, 6);
+        benchMaps(count, 12);
+    }
+}
@@ -0,0 +1,121 @@
+#include "SString8.h"
+
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    constexpr size_t hashLengths[] = { 1, 4, 7, 8, 12, 16, 24, 64, 254, 255, 1024 };
+
+    void benchHash(size_t len)
+    {
+        const std::string text(len, 'h');
+        const SString8 s8(text);
+        {
+            const SString8Hash hasher;
+            const auto result = Bench::measure([&s8, &hasher](size_t n)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Bench::doNotOptimize(s8);
+                        const auto h = hasher(s8);
+                        Bench::doNotOptimize(h);
+                    }
+                });
+            Bench::report("hash", "SString8", len, result);
+        }
+        {
+            const SString8Hash hasher;
+            const std::string_view sv(text);
+            const auto result = Bench::measure([sv, &hasher](size_t n)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Bench::doNotOptimize(sv);
+                        const auto h = hasher(sv);
+                        Bench::doNotOptimize(h);
+                    }
+                });
+            Bench::report("hash", "SString8Hash(sv)", len, result);
+        }
+        {
+            const std::hash<std::string> hasher;
+            const auto result = Bench::measure([&text, &hasher](size_t n)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Bench::doNotOptimize(text);
+                        const auto h = hasher(text);
+                        Bench::doNotOptimize(h);
+                    }
+                });
+            Bench::report("hash", "std::string", len, result);
+        }
+    }
+
+    std::vector<std::string> makeIdentifiers(size_t count, size_t len)
+    {
+        std::vector<std::string> ids;
+        ids.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::string id(len, 'k');
+            auto n = i;
+            for (size_t j = 0; j < len && n != 0; ++j, n /= 26)
+                id[j] = static_cast<char>('a' + n % 26);
+            ids.push_back(std::move(id));
+        }
+        return ids;
+    }
+
+    /** Look up every key (as a string_view) in maps holding count keys of len chars */
+    void benchLookup(size_t count, size_t len)
+    {
+        const auto ids = makeIdentifiers(count, len);
+        {
+            std::unordered_map<SString8, size_t, SString8Hash, SString8Equal> map;
+            for (size_t i = 0; i < ids.size(); ++i)
+                map.emplace(SString8(ids[i]), i);
+            const auto result = Bench::measure([&map, &ids](size_t n)
+                {
+                    size_t total = 0;
+                    for (size_t i = 0; i < n; ++i)
+                        total += map.find(std::string_view(ids[i % ids.size()]))->second;
+                    Bench::doNotOptimize(total);
+                });
+            Bench::report("unordered_map find(sv)", "SString8", len, result);
+        }
+        {
+            std::unordered_map<std::string, size_t> map;
+            for (size_t i = 0; i < ids.size(); ++i)
+                map.emplace(ids[i], i);
+            const auto result = Bench::measure([&map, &ids](size_t n)
+                {
+                    size_t total = 0;
+                    for (size_t i = 0; i < n; ++i)
+                        total += map.find(ids[i % ids.size()])->second;
+                    Bench::doNotOptimize(total);
+                });
+            Bench::report("unordered_map find", "std::string", len, result);
+        }
+    }
+}
+
+BENCH(BenchSString8Hash)
+{
+    for (const auto len : hashLengths)
+        benchHash(len);
+}
+
+BENCH(BenchSString8HashLookup)
+{
+    for (const auto len : { 6U, 12U, 40U })
+        benchLookup(100'000, len);
+}
@@ -0,0 +1,75 @@
+#include "SString8InternPool.h"
+
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr size_t opsPerThread = 1'000'000;
+    constexpr size_t distinctNames = 10'000;
+
+    /** Host and metric style names, 16 to 40 chars, so all of them are heap strings unless interned */
+    std::vector<std::string> makeNames()
+    {
+        std::vector<std::string> names;
+        names.reserve(distinctNames);
+        for (size_t i = 0; i < distinctNames; ++i)
+        {
+            if (i % 2 == 0)
+                names.push_back("host-" + std::to_string(i) + ".dc" + std::to_string(i % 7) + ".example.com");
+            else
+                names.push_back("service.requests.latency." + std::to_string(i));
+        }
+        return names;
+    }
+
+    /**
+    Each thread makes opsPerThread strings from names picked at random, as an ingestion pipeline would from the records it parses, and keeps them all.
+    Reports the time per string, and the heap bytes held per string once they are all made.
+    */
+    template<class Make>
+    void benchIngest(std::string_view variant, size_t threadCount, const std::vector<std::string>& names, Make&& make)
+    {
+        std::vector<std::vector<SString8>> kept(threadCount);
+        const auto before = Bench::allocStats();
+        const auto result = Bench::measureOnce(threadCount * opsPerThread, [&]()
+            {
+                std::vector<std::thread> threads;
+                for (size_t t = 0; t < threadCount; ++t)
+                {
+                    threads.emplace_back([&, t]()
+                        {
+                            auto& strs = kept[t];
+                            strs.reserve(opsPerThread);
+                            uint64_t seed = t;
+                            for (size_t i = 0; i < opsPerThread; ++i)
+                            {
+                                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                                strs.push_back(make(std::string_view(names[(seed >> 33U) % names.size()])));
+                            }
+                        });
+                }
+                for (auto& thread : threads)
+                    thread.join();
+            });
+        const auto liveBytes = Bench::allocStats().m_LiveBytes - before.m_LiveBytes;
+        Bench::report("intern " + std::to_string(threadCount) + " threads", variant, 0, result, liveBytes / (threadCount * opsPerThread));
+    }
+}
+
+BENCH(BenchSString8InternPool)
+{
+    const auto names = makeNames();
+    for (const size_t threadCount : { 1U, 4U })
+    {
+        benchIngest("SString8", threadCount, names, [](std::string_view name) { return SString8(name); });
+        SString8InternPool pool;
+        benchIngest("SString8InternPool", threadCount, names, [&pool](std::string_view name) { return pool.intern(name); });
+    }
+}
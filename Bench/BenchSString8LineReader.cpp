@@ -0,0 +1,110 @@
+#include "SString8LineReader.h"
+
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    constexpr size_t lineCount = 10'000'000;
+
+    /** 10M short lines (2 to 20 chars, mostly 7 or fewer), eg symbols, ids or tokens one per line */
+    std::string makeText()
+    {
+        std::string text;
+        text.reserve(lineCount * 8);
+        uint64_t seed = 0xDA942042E4DD58B5ULL;
+        for (size_t i = 0; i < lineCount; ++i)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const auto len = ((seed >> 60U) == 0) ? 8 + (seed >> 33U) % 13 : 2 + (seed >> 33U) % 6;
+            for (size_t j = 0; j < len; ++j)
+                text.push_back(static_cast<char>('a' + (seed >> (j * 3U)) % 26));
+            text.push_back('\n');
+        }
+        return text;
+    }
+
+    template<class Read>
+    void benchRead(std::string_view variant, Read&& read)
+    {
+        const auto result = Bench::measureOnce(lineCount, [&]()
+            {
+                size_t total = 0;
+                read(total);
+                Bench::doNotOptimize(total);
+            });
+        Bench::report("read 10M short lines", variant, 0, result);
+    }
+}
+
+BENCH(BenchSString8LineReader)
+{
+    const auto text = makeText();
+    const auto path = std::filesystem::temp_directory_path() / "BenchSString8LineReader.txt";
+    {
+        std::ofstream os(path, std::ios::binary);
+        os << text;
+    }
+
+    benchRead("std::getline std::string", [&](size_t& total)
+        {
+            std::ifstream is(path, std::ios::binary);
+            for (std::string line; std::getline(is, line);)
+                total += line.size();
+        });
+    // what getline into SString8 replaces
+    benchRead("std::getline then SString8", [&](size_t& total)
+        {
+            std::ifstream is(path, std::ios::binary);
+            SString8 s8;
+            for (std::string line; std::getline(is, line);)
+            {
+                s8 = line;
+                total += s8.size();
+            }
+        });
+    benchRead("getline SString8", [&](size_t& total)
+        {
+            std::ifstream is(path, std::ios::binary);
+            for (SString8 line; getline(is, line);)
+                total += line.size();
+        });
+    benchRead("operator>> std::string", [&](size_t& total)
+        {
+            std::ifstream is(path, std::ios::binary);
+            for (std::string word; is >> word;)
+                total += word.size();
+        });
+    benchRead("operator>> SString8", [&](size_t& total)
+        {
+            std::ifstream is(path, std::ios::binary);
+            for (SString8 word; is >> word;)
+                total += word.size();
+        });
+    benchRead("SString8LineReader file", [&](size_t& total)
+        {
+            auto reader = SString8LineReader::fromFile(path);
+            for (SString8 line; reader.getline(line);)
+                total += line.size();
+        });
+    benchRead("SString8LineReader memory", [&](size_t& total)
+        {
+            SString8LineReader reader(text);
+            for (SString8 line; reader.getline(line);)
+                total += line.size();
+        });
+    benchRead("SString8LineReader string_view", [&](size_t& total)
+        {
+            SString8LineReader reader(text);
+            for (std::string_view line; reader.getline(line);)
+                total += line.size();
+        });
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,74 @@
+#include "SString8.h"
+
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    constexpr size_t stringsPerRequest = 10'000;
+
+    /**
+    Requests of up to stringsPerRequest strings of len chars: build them all, then throw them all away.
+    makeScope() is called at the start of each request and its result destroyed at the end.  Reported per string.
+    */
+    template<class StringType, class MakeScope>
+    void benchRequest(std::string_view variant, size_t len, MakeScope&& makeScope)
+    {
+        const std::string text(len, 'r');
+        const std::string_view sv(text);
+        const auto result = Bench::measure([&](size_t n)
+            {
+                for (size_t done = 0; done < n; done += stringsPerRequest)
+                {
+                    [[maybe_unused]] auto scope = makeScope();
+                    const auto count = std::min(stringsPerRequest, n - done);
+                    std::vector<StringType> strs;
+                    strs.reserve(count);
+                    for (size_t i = 0; i < count; ++i)
+                        strs.emplace_back(sv);
+                    Bench::doNotOptimize(strs);
+                }
+            });
+        Bench::report("request strings", variant, len, result);
+    }
+
+    /** A monotonic arena for one request, which all the strings allocate from and which is freed in one go at the end */
+    struct ArenaScope
+    {
+        std::pmr::monotonic_buffer_resource m_Arena{ 64 * 1024 };
+        SString8ResourceScope m_Scope{ &m_Arena };
+    };
+}
+
+BENCH(BenchSString8Pmr)
+{
+    for (const auto len : { 8U, 32U, 200U, 1000U })
+    {
+        benchRequest<SString8>("SString8", len, []() { return 0; });
+        benchRequest<PmrSString8>("PmrSString8", len, []() { return std::make_unique<ArenaScope>(); });
+        benchRequest<std::string>("std::string", len, []() { return 0; });
+        // std::pmr::string can't use the scope, so it is given the arena directly
+        const auto result = Bench::measure([len](size_t n)
+            {
+                const std::string text(len, 'r');
+                for (size_t done = 0; done < n; done += stringsPerRequest)
+                {
+                    std::pmr::monotonic_buffer_resource arena(64 * 1024);
+                    const auto count = std::min(stringsPerRequest, n - done);
+                    std::pmr::vector<std::pmr::string> strs(&arena);
+                    strs.reserve(count);
+                    for (size_t i = 0; i < count; ++i)
+                        strs.emplace_back(text);
+                    Bench::doNotOptimize(strs);
+                }
+            });
+        Bench::report("request strings", "std::pmr::string", len, result);
+    }
+}
@@ -0,0 +1,112 @@
+#include "SString8.h"
+
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using SString8Detail::Search::Level;
+
+    /** Log lines of 60-120 chars, mostly INFO, with the occasional WARN and ERROR */
+    std::vector<std::string> makeLogLines(size_t count)
+    {
+        const char* levels[] = { "INFO", "INFO", "INFO", "INFO", "INFO", "INFO", "DEBUG", "DEBUG", "WARN", "ERROR" };
+        const char* paths[] = { "/api/v1/items", "/api/v1/items/search", "/health", "/api/v2/users/profile/settings", "/static/app.js" };
+        std::vector<std::string> lines;
+        lines.reserve(count);
+        uint64_t seed = 0x9E3779B97F4A7C15ULL;
+        for (size_t i = 0; i < count; ++i)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            std::string line = "2026-10-18T12:" + std::to_string(10 + (seed >> 58U)) + ":07.123Z ";
+            line += levels[(seed >> 33U) % std::size(levels)];
+            line += " [worker-" + std::to_string((seed >> 40U) % 16) + "] request id=" + std::to_string((seed >> 20U) % 100000);
+            line += " path=";
+            line += paths[(seed >> 45U) % std::size(paths)];
+            line += " status=" + std::to_string(((seed >> 50U) % 8 == 0) ? 500 : 200) + " latency_ms=" + std::to_string((seed >> 52U) % 1000);
+            lines.push_back(std::move(line));
+        }
+        return lines;
+    }
+
+    /** Time one search over every line, as SString8 at each kernel level and as std::string_view */
+    template<class Search>
+    void benchSearch(std::string_view name, const std::vector<std::string>& lines, const std::vector<SString8>& sstrings, Search&& search)
+    {
+        const auto best = SString8Detail::Search::bestLevel();
+        for (const auto level : { Level::SCALAR, Level::SSE2, Level::AVX2 })
+        {
+            if (level > best)
+                continue;
+            SString8Detail::Search::setLevel(level);
+            const auto result = Bench::measure([&](size_t n)
+                {
+                    size_t total = 0;
+                    for (size_t i = 0, j = 0; i < n; ++i, j = (j + 1 == sstrings.size()) ? 0 : j + 1)
+                        total += search(sstrings[j]);
+                    Bench::doNotOptimize(total);
+                });
+            const char* variants[] = { "SString8 scalar", "SString8 SSE2", "SString8 AVX2" };
+            Bench::report(name, variants[static_cast<size_t>(level)], 0, result);
+        }
+        SString8Detail::Search::setLevel(best);
+
+        // views of copies, made as the SString8s were, rather than of lines themselves, whose chars were grown with += into allocations
+        // of a few sizes: that gives memchr the same alignments over and over, which it predicts far better than those of strings packed one after another
+        const std::vector<std::string> copies(lines.begin(), lines.end());
+        std::vector<std::string_view> views(copies.begin(), copies.end());
+        const auto result = Bench::measure([&](size_t n)
+            {
+                size_t total = 0;
+                for (size_t i = 0, j = 0; i < n; ++i, j = (j + 1 == views.size()) ? 0 : j + 1)
+                    total += search(views[j]);
+                Bench::doNotOptimize(total);
+            });
+        Bench::report(name, "std::string_view", 0, result);
+    }
+}
+
+BENCH(BenchSString8SearchLogLines)
+{
+    const auto lines = makeLogLines(4096);
+    const std::vector<SString8> sstrings(lines.begin(), lines.end());
+
+    benchSearch("log find(' ')", lines, sstrings, [](const auto& line) { return line.find(' '); });
+    benchSearch("log find(\"id=\")", lines, sstrings, [](const auto& line) { return line.find("id="); });
+    benchSearch("log find(\"ERROR\")", lines, sstrings, [](const auto& line) { return line.find("ERROR"); });
+    benchSearch("log find(\" status=500\")", lines, sstrings, [](const auto& line) { return line.find(" status=500"); });
+    benchSearch("log rfind('/')", lines, sstrings, [](const auto& line) { return line.rfind('/'); });
+    benchSearch("log find_first_of(\"=]\")", lines, sstrings, [](const auto& line) { return line.find_first_of("=]", 24); });
+    benchSearch("log find_last_not_of(\"0-9\")", lines, sstrings, [](const auto& line) { return line.find_last_not_of("0123456789"); });
+}
+
+BENCH(BenchSString8SearchFields)
+{
+    // the fields of the log lines, most of which fit in the buffer, so are searched in their word
+    std::vector<std::string> fields;
+    for (const auto& line : makeLogLines(512))
+    {
+        for (size_t start = 0; start < line.size();)
+        {
+            auto end = line.find_first_of(" =", start);
+            if (end == std::string::npos)
+                end = line.size();
+            fields.push_back(line.substr(start, end - start));
+            start = end + 1;
+        }
+    }
+    const std::vector<SString8> sstrings(fields.begin(), fields.end());
+
+    benchSearch("field find('-')", fields, sstrings, [](const auto& field) { return field.find('-'); });
+    benchSearch("field find(\"id\")", fields, sstrings, [](const auto& field) { return field.find("id"); });
+    benchSearch("field find(\"INFO\")", fields, sstrings, [](const auto& field) { return field.find("INFO"); });
+    benchSearch("field find_first_of(\"[]\")", fields, sstrings, [](const auto& field) { return field.find_first_of("[]"); });
+}
@@ -0,0 +1,120 @@
+#include "SString8.h"
+
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr size_t opsPerThread = 1'000'000;
+    constexpr size_t liveStrings = 4096;
+    constexpr size_t handoffBatch = 256;
+
+    /** Small tier lengths, 8 to 254 */
+    size_t nextLength(uint64_t& seed)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return 8 + (seed >> 33U) % 247;
+    }
+
+    /** Each thread keeps liveStrings strings, and replaces a random one with a new string of random small tier length opsPerThread times */
+    template<class StringType>
+    void benchChurn(std::string_view variant, size_t threadCount)
+    {
+        const std::string text(254, 'c');
+        const auto result = Bench::measureOnce(threadCount * opsPerThread, [&text, threadCount]()
+            {
+                std::vector<std::thread> threads;
+                for (size_t t = 0; t < threadCount; ++t)
+                {
+                    threads.emplace_back([&text, t]()
+                        {
+                            std::vector<StringType> strs(liveStrings);
+                            uint64_t seed = t;
+                            for (size_t i = 0; i < opsPerThread; ++i)
+                            {
+                                const auto len = nextLength(seed);
+                                strs[seed & (liveStrings - 1)] = StringType(std::string_view(text.data(), len));
+                            }
+                            Bench::doNotOptimize(strs);
+                        });
+                }
+                for (auto& thread : threads)
+                    thread.join();
+            });
+        Bench::report("slab churn " + std::to_string(threadCount) + " threads", variant, 0, result);
+    }
+
+    /** Where a thread leaves strings for the next thread in the ring to destroy */
+    template<class StringType>
+    struct Mailbox
+    {
+        std::mutex m_Mutex;
+        std::vector<StringType> m_Strings;
+    };
+
+    /** Each thread makes strings in batches and hands each batch to the next thread, which destroys them, so every free is from another thread */
+    template<class StringType>
+    void benchHandoff(std::string_view variant, size_t threadCount)
+    {
+        const std::string text(254, 'h');
+        const auto result = Bench::measureOnce(threadCount * opsPerThread, [&text, threadCount]()
+            {
+                std::vector<Mailbox<StringType>> mailboxes(threadCount);
+                std::vector<std::thread> threads;
+                for (size_t t = 0; t < threadCount; ++t)
+                {
+                    threads.emplace_back([&text, &mailboxes, t, threadCount]()
+                        {
+                            auto& next = mailboxes[(t + 1) % threadCount];
+                            auto& mine = mailboxes[t];
+                            uint64_t seed = t;
+                            std::vector<StringType> batch;
+                            std::vector<StringType> received;
+                            for (size_t i = 0; i < opsPerThread; i += handoffBatch)
+                            {
+                                batch.clear();
+                                for (size_t j = 0; j < handoffBatch; ++j)
+                                    batch.emplace_back(std::string_view(text.data(), nextLength(seed)));
+                                {
+                                    const std::lock_guard<std::mutex> lock(next.m_Mutex);
+                                    for (auto& str : batch)
+                                        next.m_Strings.push_back(std::move(str));
+                                }
+                                {
+                                    const std::lock_guard<std::mutex> lock(mine.m_Mutex);
+                                    std::swap(received, mine.m_Strings);
+                                }
+                                received.clear();
+                            }
+                        });
+                }
+                for (auto& thread : threads)
+                    thread.join();
+            });
+        Bench::report("slab handoff " + std::to_string(threadCount) + " threads", variant, 0, result);
+    }
+}
+
+BENCH(BenchSString8Slab)
+{
+    for (const size_t threadCount : { 1U, 2U, 4U })
+    {
+        benchChurn<basic_SString8<std::allocator<char>>>("SString8", threadCount);
+        benchChurn<SlabSString8>("SlabSString8", threadCount);
+        benchChurn<std::string>("std::string", threadCount);
+    }
+    for (const size_t threadCount : { 2U, 4U })
+    {
+        benchHandoff<basic_SString8<std::allocator<char>>>("SString8", threadCount);
+        benchHandoff<SlabSString8>("SlabSString8", threadCount);
+        benchHandoff<std::string>("std::string", threadCount);
+    }
+}
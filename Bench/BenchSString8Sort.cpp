@@ -0,0 +1,144 @@
+#include "SString8Sort.h"
+
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    constexpr size_t numKeys = 10'000'000;
+
+    template<class StringType>
+    constexpr std::string_view typeName()
+    {
+        if constexpr (std::is_same_v<StringType, SString8>)
+            return "SString8";
+        else
+            return "std::string";
+    }
+
+    /** numKeys random keys of minLen to maxLen chars from a 16 letter alphabet, so that there are plenty of duplicates among the short ones */
+    std::vector<std::string> makeKeys(size_t minLen, size_t maxLen)
+    {
+        std::vector<std::string> keys;
+        keys.reserve(numKeys);
+        uint64_t rnd = 88172645463325252ULL;
+        auto next = [&rnd]()
+            {
+                // xorshift64
+                rnd ^= rnd << 13U;
+                rnd ^= rnd >> 7U;
+                rnd ^= rnd << 17U;
+                return rnd;
+            };
+        for (size_t i = 0; i < numKeys; ++i)
+        {
+            auto bits = next();
+            const auto len = minLen + bits % (maxLen - minLen + 1);
+            bits = next();
+            std::string key;
+            for (size_t j = 0; j < len; ++j, bits >>= 4U)
+                key.push_back(static_cast<char>('a' + (bits & 0xFU)));
+            keys.push_back(std::move(key));
+        }
+        return keys;
+    }
+
+    template<class StringType>
+    void benchSortUnique(std::string_view name, const std::vector<std::string>& source)
+    {
+        std::vector<StringType> keys(source.begin(), source.end());
+        size_t unique = 0;
+        const auto result = Bench::measureOnce(keys.size(), [&keys, &unique]()
+            {
+                std::sort(keys.begin(), keys.end());
+                unique = static_cast<size_t>(std::unique(keys.begin(), keys.end()) - keys.begin());
+            });
+        Bench::doNotOptimize(unique);
+        Bench::report(name, typeName<StringType>(), source.size(), result);
+    }
+
+    /** Sort a copy of source with each way of sorting SString8s, and with std::sort of std::string for comparison */
+    void benchSortAlgorithms(std::string_view name, const std::vector<std::string>& source)
+    {
+        const auto benchOne = [&](std::string_view variant, auto sort)
+            {
+                std::vector<SString8> keys(source.begin(), source.end());
+                const auto result = Bench::measureOnce(keys.size(), [&keys, &sort]()
+                    {
+                        sort(keys);
+                    });
+                Bench::doNotOptimize(keys);
+                Bench::report(name, variant, source.size(), result);
+            };
+        benchOne("std::sort", [](auto& keys) { std::sort(keys.begin(), keys.end()); });
+        benchOne("sort_sstring8", [](auto& keys) { sort_sstring8(keys.begin(), keys.end()); });
+        benchOne("std::stable_sort", [](auto& keys) { std::stable_sort(keys.begin(), keys.end()); });
+        benchOne("stable_sort_sstring8", [](auto& keys) { stable_sort_sstring8(keys.begin(), keys.end()); });
+        benchOne("parallel_sort_sstring8", [](auto& keys) { parallel_sort_sstring8(keys.begin(), keys.end()); });
+
+        std::vector<std::string> strings(source);
+        const auto result = Bench::measureOnce(strings.size(), [&strings]()
+            {
+                std::sort(strings.begin(), strings.end());
+            });
+        Bench::report(name, "std::string", source.size(), result);
+    }
+
+    /** Sort source in groups of groupSize strings, eg the values of many small records, where setting up a sort costs as much as sorting */
+    void benchSortGroups(size_t groupSize, const std::vector<std::string>& source)
+    {
+        const auto name = "sort groups of " + std::to_string(groupSize) + " (per string)";
+        const auto benchOne = [&](std::string_view variant, auto sort)
+            {
+                std::vector<SString8> keys(source.begin(), source.end());
+                const auto result = Bench::measureOnce(keys.size(), [&keys, &sort, groupSize]()
+                    {
+                        for (size_t i = 0; i + groupSize <= keys.size(); i += groupSize)
+                            sort(keys.begin() + static_cast<std::ptrdiff_t>(i), keys.begin() + static_cast<std::ptrdiff_t>(i + groupSize));
+                    });
+                Bench::doNotOptimize(keys);
+                Bench::report(name, variant, 0, result);
+            };
+        benchOne("std::sort", [](auto first, auto last) { std::sort(first, last); });
+        benchOne("sort_sstring8", [](auto first, auto last) { sort_sstring8(first, last); });
+        benchOne("std::stable_sort", [](auto first, auto last) { std::stable_sort(first, last); });
+        benchOne("stable_sort_sstring8", [](auto first, auto last) { stable_sort_sstring8(first, last); });
+    }
+}
+
+BENCH(BenchSString8SortUniqueShort)
+{
+    // all inline for SString8
+    const auto keys = makeKeys(1, 7);
+    benchSortUnique<SString8>("sort+unique 1-7 chars", keys);
+    benchSortUnique<std::string>("sort+unique 1-7 chars", keys);
+}
+
+BENCH(BenchSString8SortUniqueHeap)
+{
+    // all small tier for SString8, all in the SSO buffer for std::string
+    const auto keys = makeKeys(8, 15);
+    benchSortUnique<SString8>("sort+unique 8-15 chars", keys);
+    benchSortUnique<std::string>("sort+unique 8-15 chars", keys);
+}
+
+BENCH(BenchSString8SortRadix)
+{
+    benchSortAlgorithms("sort 1-7 chars", makeKeys(1, 7));
+    benchSortAlgorithms("sort 8-15 chars", makeKeys(8, 15));
+    benchSortAlgorithms("sort 8-40 chars", makeKeys(8, 40));
+}
+
+BENCH(BenchSString8SortSmall)
+{
+    const auto keys = makeKeys(1, 15);
+    for (const size_t groupSize : { 2U, 8U, 32U, 64U, 128U, 512U })
+        benchSortGroups(groupSize, keys);
+}
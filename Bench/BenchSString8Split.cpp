@@ -0,0 +1,116 @@
+#include "SString8Split.h"
+
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    /** Records of short fields, eg a trade or sensor feed: an id, a date, codes, small numbers and the occasional longer name */
+    std::vector<std::string> makeRecords(size_t count, char delimiter)
+    {
+        const char* codes[] = { "GB", "FR", "DE", "US", "JP" };
+        const char* names[] = { "Acme", "Globex", "Initech", "Umbrella Corporation", "Wayne Enterprises" };
+        std::vector<std::string> records;
+        records.reserve(count);
+        uint64_t seed = 0x2545F4914F6CDD1DULL;
+        for (size_t i = 0; i < count; ++i)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            std::string record = std::to_string(100000 + i);
+            for (const auto& field : { std::string("2026-10-18"), std::string(codes[(seed >> 33U) % 5]), std::to_string((seed >> 20U) % 1000),
+                std::to_string((seed >> 40U) % 100) + "." + std::to_string((seed >> 50U) % 100), std::string(names[(seed >> 45U) % 5]),
+                std::string((seed >> 55U) % 2 ? "Y" : "N"), std::to_string((seed >> 10U) % 50000), std::string("EUR") })
+            {
+                record += delimiter;
+                record += field;
+            }
+            records.push_back(std::move(record));
+        }
+        return records;
+    }
+
+    /** Split each record into a reused vector, reporting ns and allocations per record */
+    template<class Fields, class Split>
+    void benchSplit(std::string_view name, std::string_view variant, const std::vector<std::string>& records, Split&& split)
+    {
+        Fields fields;
+        split(records[0], fields);
+        const auto result = Bench::measure([&](size_t n)
+            {
+                size_t total = 0;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    split(records[i % records.size()], fields);
+                    total += fields.size();
+                }
+                Bench::doNotOptimize(total);
+            });
+        Bench::report(name, variant, 0, result);
+    }
+
+    void benchRecords(std::string_view name, char delimiter)
+    {
+        using SString8Detail::Search::Level;
+        const auto records = makeRecords(4096, delimiter);
+
+        const auto best = SString8Detail::Search::bestLevel();
+        for (const auto level : { Level::SCALAR, Level::SSE2, Level::AVX2 })
+        {
+            if (level > best)
+                continue;
+            SString8Detail::Search::setLevel(level);
+            const char* variants[] = { "split_sstring8 scalar", "split_sstring8 SSE2", "split_sstring8 AVX2" };
+            benchSplit<std::vector<SString8>>(name, variants[static_cast<size_t>(level)], records, [delimiter](std::string_view record, std::vector<SString8>& fields)
+                {
+                    split_sstring8(record, delimiter, fields);
+                });
+        }
+        SString8Detail::Search::setLevel(best);
+
+        // what split_sstring8 replaces: string_views found a field at a time, each copied into a new SString8
+        benchSplit<std::vector<SString8>>(name, "string_view then SString8", records, [delimiter](std::string_view record, std::vector<SString8>& fields)
+            {
+                fields.clear();
+                for (size_t start = 0;;)
+                {
+                    const auto end = record.find(delimiter, start);
+                    fields.emplace_back(record.substr(start, end - start));
+                    if (end == std::string_view::npos)
+                        break;
+                    start = end + 1;
+                }
+            });
+        benchSplit<std::vector<std::string>>(name, "vector<string> reused", records, [delimiter](std::string_view record, std::vector<std::string>& fields)
+            {
+                size_t count = 0;
+                for (size_t start = 0;; ++count)
+                {
+                    const auto end = record.find(delimiter, start);
+                    const auto field = record.substr(start, end - start);
+                    if (count < fields.size())
+                        fields[count].assign(field);
+                    else
+                        fields.emplace_back(field);
+                    if (end == std::string_view::npos)
+                        break;
+                    start = end + 1;
+                }
+                fields.resize(count + 1);
+            });
+    }
+}
+
+BENCH(BenchSString8SplitCsv)
+{
+    benchRecords("split csv record", ',');
+}
+
+BENCH(BenchSString8SplitTsv)
+{
+    benchRecords("split tsv record", '\t');
+}
@@ -0,0 +1,84 @@
+#include "SString8FlatMap.h"
+#include "SString8Switch.h"
+
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // HTTP methods, and a long one to make the if-else chains and the switch's long key path do some work
+    using Methods = SString8Switch<"GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH", "PROPFIND">;
+    constexpr const char* methodNames[] = { "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH", "PROPFIND" };
+
+    /** Tokens as a request parser would see them: mostly GET and POST, some of the rest, and some that aren't methods */
+    std::vector<std::string> makeTokens(size_t count)
+    {
+        std::vector<std::string> tokens;
+        tokens.reserve(count);
+        uint64_t seed = 0x9E3779B97F4A7C15ULL;
+        for (size_t i = 0; i < count; ++i)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const auto r = (seed >> 33U) % 100;
+            if (r < 50)
+                tokens.emplace_back("GET");
+            else if (r < 75)
+                tokens.emplace_back("POST");
+            else if (r < 95)
+                tokens.emplace_back(methodNames[r % std::size(methodNames)]);
+            else
+                tokens.emplace_back("BREW");
+        }
+        return tokens;
+    }
+
+    template<class Token, class Find>
+    void benchFind(std::string_view variant, const std::vector<Token>& tokens, Find&& find)
+    {
+        const auto result = Bench::measure([&](size_t n)
+            {
+                size_t total = 0;
+                for (size_t i = 0; i < n; ++i)
+                    total += find(tokens[i % tokens.size()]);
+                Bench::doNotOptimize(total);
+            });
+        Bench::report("keyword dispatch", variant, 0, result);
+    }
+
+    template<class String>
+    size_t ifElseChain(const String& token)
+    {
+        for (size_t i = 0; i < std::size(methodNames); ++i)
+        {
+            if (token == methodNames[i])
+                return i;
+        }
+        return Methods::npos;
+    }
+}
+
+BENCH(BenchSString8Switch)
+{
+    const auto strings = makeTokens(4096);
+    const std::vector<SString8> sstrings(strings.begin(), strings.end());
+
+    benchFind("SString8Switch", sstrings, [](const SString8& token) { return Methods::find(token); });
+    benchFind("if-else SString8", sstrings, [](const SString8& token) { return ifElseChain(token); });
+    benchFind("if-else string", strings, [](const std::string& token) { return ifElseChain(token); });
+
+    std::unordered_map<std::string, size_t> map;
+    SString8FlatMap<size_t> flatMap;
+    for (size_t i = 0; i < std::size(methodNames); ++i)
+    {
+        map.emplace(methodNames[i], i);
+        flatMap.try_emplace(std::string_view(methodNames[i]), i);
+    }
+    benchFind("unordered_map", strings, [&map](const std::string& token) { const auto it = map.find(token); return (it == map.end()) ? Methods::npos : it->second; });
+    benchFind("SString8FlatMap", sstrings, [&flatMap](const SString8& token) { const auto it = flatMap.find(token); return (it == flatMap.end()) ? Methods::npos : it->second; });
+}
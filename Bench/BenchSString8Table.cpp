@@ -0,0 +1,78 @@
+#include "SString8Table.h"
+
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    constexpr size_t keyCount = 2'000'000;
+    constexpr size_t lookups = 1000;
+
+    /** Dictionary style keys, 4 to 40 chars */
+    std::vector<std::string> makeKeys()
+    {
+        std::vector<std::string> keys;
+        keys.reserve(keyCount);
+        for (size_t i = 0; i < keyCount; ++i)
+            keys.push_back(std::to_string(i) + std::string(i % 37, static_cast<char>('a' + i % 26)));
+        return keys;
+    }
+}
+
+/**
+What starting a process costs with a dictionary on disk: reading it all back into a vector<SString8>,
+against mapping a string table and reading just the keys that are needed (with the file in the page cache, so this is the cost of the copies and allocations).
+*/
+BENCH(BenchSString8Table)
+{
+    const auto keys = makeKeys();
+    const auto path = std::filesystem::temp_directory_path() / "BenchSString8Table.bin";
+    {
+        std::ofstream os(path, std::ios::binary);
+        writeSString8Table(os, keys);
+    }
+
+    const auto rebuildResult = Bench::measureOnce(keyCount, [&path]()
+        {
+            SString8TableView table(path);
+            std::vector<SString8> strs;
+            strs.reserve(table.size());
+            for (size_t i = 0; i < table.size(); ++i)
+                strs.emplace_back(table.view(i));
+            Bench::doNotOptimize(strs);
+        });
+    Bench::report("table load 2M keys", "copy to vector", 0, rebuildResult);
+
+    const auto mapResult = Bench::measureOnce(keyCount, [&path]()
+        {
+            SString8TableView table(path);
+            size_t total = 0;
+            uint64_t seed = 1;
+            for (size_t i = 0; i < lookups; ++i)
+            {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                total += table[(seed >> 33U) % table.size()].size();
+            }
+            Bench::doNotOptimize(total);
+        });
+    Bench::report("table load 2M keys", "mmap + 1000 reads", 0, mapResult);
+
+    const auto scanResult = Bench::measureOnce(keyCount, [&path]()
+        {
+            SString8TableView table(path);
+            size_t total = 0;
+            for (size_t i = 0; i < table.size(); ++i)
+                total += table.view(i).size();
+            Bench::doNotOptimize(total);
+        });
+    Bench::report("table load 2M keys", "mmap + full scan", 0, scanResult);
+
+    std::filesystem::remove(path);
+}
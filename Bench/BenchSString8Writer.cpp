@@ -0,0 +1,124 @@
+#include "SString8Writer.h"
+
+#include "Bench.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr size_t fieldCount = 10'000'000;
+    constexpr size_t fieldsPerRow = 8;
+
+    /** Short fields (mostly 7 chars or fewer, some up to 20), with a longer free text field in some rows, as the columns of a typical record */
+    std::vector<SString8> makeFields()
+    {
+        std::vector<SString8> fields;
+        fields.reserve(fieldCount);
+        uint64_t seed = 0x2545F4914F6CDD1DULL;
+        std::string field;
+        for (size_t i = 0; i < fieldCount; ++i)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            size_t len = ((seed >> 60U) == 0) ? 8 + (seed >> 33U) % 13 : 1 + (seed >> 33U) % 7;
+            if (i % fieldsPerRow == fieldsPerRow - 1)
+                len = ((seed >> 56U) % 4 == 0) ? 150 + (seed >> 20U) % 100 : 0;
+            field.assign(len, static_cast<char>('a' + (seed >> 40U) % 26));
+            fields.emplace_back(std::string_view(field));
+        }
+        return fields;
+    }
+
+    template<class Write>
+    void benchWrite(std::string_view variant, const std::filesystem::path& path, Write&& write)
+    {
+        const auto result = Bench::measureOnce(fieldCount, [&]()
+            {
+                write();
+            });
+        Bench::report("write 10M fields as tsv", variant, 0, result);
+        std::filesystem::remove(path);
+    }
+
+    /** A new file, for a variant that writes to a file descriptor (a HANDLE on Windows) */
+    SString8Writer::Handle create(const std::filesystem::path& path)
+    {
+#if defined(_WIN32)
+        return CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+        return open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    }
+
+    void close(SString8Writer::Handle handle)
+    {
+#if defined(_WIN32)
+        CloseHandle(handle);
+#else
+        ::close(handle);
+#endif
+    }
+
+    void benchWriter(std::string_view variant, const std::filesystem::path& path, const std::vector<SString8>& fields, size_t copyBelow)
+    {
+        benchWrite(variant, path, [&]()
+            {
+                const auto handle = create(path);
+                {
+                    SString8Writer writer(handle, copyBelow);
+                    for (size_t i = 0; i < fields.size(); i += fieldsPerRow)
+                        writer.writeAll(std::span(fields.data() + i, fieldsPerRow), "\t", "\n");
+                    writer.flush();
+                }
+                close(handle);
+            });
+    }
+}
+
+BENCH(BenchSString8Writer)
+{
+    const auto fields = makeFields();
+    const auto path = std::filesystem::temp_directory_path() / "BenchSString8Writer.txt";
+
+    // what SString8Writer replaces: through an ostream, one string at a time
+    benchWrite("ofstream << data()", path, [&]()
+        {
+            std::ofstream os(path, std::ios::binary);
+            for (size_t i = 0; i < fields.size(); ++i)
+                os << fields[i].data() << ((i % fieldsPerRow == fieldsPerRow - 1) ? '\n' : '\t');
+        });
+    benchWrite("ofstream << SString8", path, [&]()
+        {
+            std::ofstream os(path, std::ios::binary);
+            for (size_t i = 0; i < fields.size(); ++i)
+                os << fields[i] << ((i % fieldsPerRow == fieldsPerRow - 1) ? '\n' : '\t');
+        });
+    benchWrite("ofstream write", path, [&]()
+        {
+            std::ofstream os(path, std::ios::binary);
+            for (size_t i = 0; i < fields.size(); ++i)
+            {
+                os.write(fields[i].data(), static_cast<std::streamsize>(fields[i].size()));
+                os.put((i % fieldsPerRow == fieldsPerRow - 1) ? '\n' : '\t');
+            }
+        });
+    benchWriter("SString8Writer copy below 8", path, fields, 8);
+    benchWriter("SString8Writer copy below 32", path, fields, 32);
+    benchWriter("SString8Writer copy below 128", path, fields, 128);
+    benchWriter("SString8Writer copy all", path, fields, size_t(1) << 20U);
+}
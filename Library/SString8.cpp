@@ -6,8 +6,12 @@
 #include <cstddef>
 #include <string_view>
 #include <string>
+#include <istream>
+#include <iterator>
+#include <locale>
 
-SString8Detail::SString8Data::SString8Data(size_t count, char ch)
+template<class Alloc>
+SString8Detail::basic_SString8Data<Alloc>::basic_SString8Data(size_t count, char ch)
 {
     if (count <= 7)
     {
@@ -17,10 +21,10 @@ SString8Detail::SString8Data::SString8Data(size_t count, char ch)
     }
     else
     {
-        auto cap = calcCapacity(count);
+        const auto cap = usableCapacity(calcCapacity(count));
 
-        const auto offset = (cap <= max_size_small) ? 0U : (cap <= fifeteen_bites_set) ? 8U : 16U;
-        auto ptr = new char[cap + offset + 1];
+        const auto offset = headerSize(cap) - refCountSize(cap);
+        auto ptr = allocateHeap(cap);
         auto p = ptr + offset;
         std::for_each(p, p + count, [ch](char& c) { c = ch; });
         p[count] = '\0';
@@ -34,139 +38,597 @@ SString8Detail::SString8Data::SString8Data(size_t count, char ch)
     }
 }
 
-SString8::operator std::string_view() const
+template<class Alloc>
+basic_SString8<Alloc>::operator std::string_view() const
 {
-    return { data(), length() };
+    const auto [ptr, len] = m_Storage.getDataAndSize();
+    return { ptr, len };
 }
 
-SString8::SString8(std::string_view str)
-    : m_Storage(str)
+template<class Alloc>
+basic_SString8<Alloc>::basic_SString8(const std::string& str)
+    : m_Storage(str.data(), str.size())
 {
 }
 
-SString8::SString8(const std::string& str)
-    : m_Storage(str.data(), str.size())
+template<class Alloc>
+basic_SString8<Alloc>::basic_SString8(size_t count, char ch)
+    : m_Storage(count, ch)
 {
 }
 
-SString8::SString8(size_t count, char ch)
-    : m_Storage(count, ch)
+template<class Alloc>
+basic_SString8<Alloc>::basic_SString8(const basic_SString8& other, size_type pos, size_type count)
+    : m_Storage(other.data() + pos + basic_SString8::check_out_of_range(other, pos), basic_SString8::check_count(other, pos, count))
 {
 }
 
-SString8::SString8(const SString8& other, size_type pos, size_type count)
-    : m_Storage(other.data() + pos + SString8::check_out_of_range(other, pos), SString8::check_count(other, pos, count))
+template<class Alloc>
+basic_SString8<Alloc>::basic_SString8(const std::string& other, size_type pos, size_type count)
+    : m_Storage(other.data() + pos + basic_SString8::check_out_of_range(other, pos), basic_SString8::check_count(other, pos, count))
 {
 }
 
-SString8::SString8(const std::string& other, size_type pos, size_type count)
-    : m_Storage(other.data() + pos + SString8::check_out_of_range(other, pos), SString8::check_count(other, pos, count))
+template<class Alloc>
+basic_SString8<Alloc>::basic_SString8(const basic_SString8& other, size_type pos)
+    : m_Storage(other.data() + pos + basic_SString8::check_out_of_range(other, pos), other.length()-pos)
 {
 }
 
-SString8::SString8(const SString8& other, size_type pos)
-    : m_Storage(other.data() + pos + SString8::check_out_of_range(other, pos), other.length()-pos)
+template<class Alloc>
+basic_SString8<Alloc>::basic_SString8(const std::string& other, size_type pos)
+    : m_Storage(other.data() + pos + basic_SString8::check_out_of_range(other, pos), other.length() - pos)
 {
 }
 
-SString8::SString8(const std::string& other, size_type pos)
-    : m_Storage(other.data() + pos + SString8::check_out_of_range(other, pos), other.length() - pos)
+template<class Alloc>
+basic_SString8<Alloc> basic_SString8<Alloc>::borrow(std::string_view str)
 {
+    basic_SString8 result;
+    result.m_Storage.borrow(str.data(), str.size());
+    return result;
 }
 
-SString8::SString8(const CharT* s, size_type count)
-    : m_Storage(s, count)
+template<class Alloc>
+bool basic_SString8<Alloc>::isBorrowed() const noexcept
 {
+    return m_Storage.isBorrowed();
 }
 
-SString8::SString8(const CharT* s)
-    : m_Storage(s, strlen(s))
+template<class Alloc>
+basic_SString8<Alloc>::basic_SString8(std::initializer_list<CharT> ilist)
+    : basic_SString8(ilist.begin(), ilist.size())
 {
 }
 
-SString8::SString8(std::initializer_list<CharT> ilist)
-    : SString8(ilist.begin(), ilist.size())
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::operator=(const CharT* s)
 {
+    m_Storage.assign(s, strlen(s));
+    return *this;
 }
 
-SString8& SString8::operator=(const CharT* s)
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::operator=(const std::string& str)
 {
-    // TODO - a bit inefficient as we have worked out the storage type to get the ptr and capacity, and then we do the same again in setSize
-    const auto newlen = strlen(s);
-    const auto [oldptr, oldcap] = m_Storage.getDataAndCap();
-    if (newlen <= oldcap)
-    {
-        strcpy(oldptr, s);
-        m_Storage.setSize(newlen);
-    }
-    else
+    m_Storage.assign(str.data(), str.size());
+    return *this;
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::operator=(CharT ch)
+{
+    const auto decoded = m_Storage.decode();
+    if (!m_Storage.fitsInPlace(decoded, 1))
     {
-        m_Storage.allocateWithDeallocate(s, newlen);
+        m_Storage.allocateWithDeallocate(&ch, 1);
+        return *this;
     }
+    ASSERT(decoded.m_Capacity > 2);
+    decoded.m_pData[0] = ch;
+    decoded.m_pData[1] = '\0';
+    m_Storage.setSize(1, decoded.m_Type);
     return *this;
 }
 
-SString8& SString8::operator=(CharT ch)
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::operator=(std::initializer_list<CharT> ilist)
 {
-    // TODO - a bit inefficient as we have worked out the storage type to get the ptr and capacity, and then we do the same again in setSize
-    const auto [oldptr, oldcap] = m_Storage.getDataAndCap();
-    ASSERT(oldcap > 2);
-    oldptr[0] = ch;
-    oldptr[1] = '\0';
-    m_Storage.setSize(1);
+    m_Storage.assign(ilist.begin(), ilist.size());
     return *this;
 }
 
-SString8& SString8::operator=(std::initializer_list<CharT> ilist)
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::assign(size_type count, CharT ch)
+{
+    m_Storage.assignWith(count, [count, ch](char* pDest) { memset(pDest, ch, count); });
+    return *this;
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::assign(const basic_SString8& str)
+{
+    m_Storage = str.m_Storage;
+    return *this;
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::assign(const basic_SString8& str, size_type pos, size_type count)
+{
+    const auto n = basic_SString8::check_count(str, pos, count);
+    m_Storage.assign(str.data() + pos, n);
+    return *this;
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::assign(const CharT* s, size_type count)
+{
+    m_Storage.assign(s, count);
+    return *this;
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::assign(const CharT* s)
+{
+    m_Storage.assign(s, strlen(s));
+    return *this;
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::assign(std::initializer_list<CharT> ilist)
+{
+    m_Storage.assign(ilist.begin(), ilist.size());
+    return *this;
+}
+
+template<class Alloc>
+const typename basic_SString8<Alloc>::CharT* basic_SString8<Alloc>::data() const noexcept
+{
+    return m_Storage.data();
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::CharT* basic_SString8<Alloc>::data()
+{
+    // the chars may be written through the result, so a borrowed or shared string must first get its own copy
+    m_Storage.makeWritable();
+    return m_Storage.data();
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::capacity() const noexcept
+{
+    return m_Storage.capacity();
+}
+
+template<class Alloc>
+int basic_SString8<Alloc>::compare(const CharT* s) const noexcept
+{
+    return m_Storage.compare(s, strlen(s));
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::rfind(const basic_SString8& str, size_type pos) const noexcept
 {
-    // TODO - a bit inefficient as we have worked out the storage type to get the ptr and capacity, and then we do the same again in setSize
-    const auto newlen = ilist.size();
-    const auto [oldptr, oldcap] = m_Storage.getDataAndCap();
-    if (newlen <= oldcap)
+    const auto [pStr, len] = str.m_Storage.getDataAndSize();
+    return m_Storage.rfind(pStr, len, pos);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::rfind(const CharT* s, size_type pos, size_type count) const
+{
+    return m_Storage.rfind(s, count, pos);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::rfind(const CharT* s, size_type pos) const
+{
+    return rfind(s, pos, strlen(s));
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::rfind(CharT ch, size_type pos) const noexcept
+{
+    return m_Storage.rfind(ch, pos);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_first_of(const basic_SString8& str, size_type pos) const noexcept
+{
+    const auto [pStr, len] = str.m_Storage.getDataAndSize();
+    return m_Storage.findOf(pStr, len, pos, false);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_first_of(const CharT* s, size_type pos, size_type count) const
+{
+    return m_Storage.findOf(s, count, pos, false);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_first_of(const CharT* s, size_type pos) const
+{
+    return find_first_of(s, pos, strlen(s));
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_first_of(CharT ch, size_type pos) const noexcept
+{
+    return m_Storage.find(ch, pos);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_first_not_of(const basic_SString8& str, size_type pos) const noexcept
+{
+    const auto [pStr, len] = str.m_Storage.getDataAndSize();
+    return m_Storage.findOf(pStr, len, pos, true);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_first_not_of(const CharT* s, size_type pos, size_type count) const
+{
+    return m_Storage.findOf(s, count, pos, true);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_first_not_of(const CharT* s, size_type pos) const
+{
+    return find_first_not_of(s, pos, strlen(s));
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_first_not_of(CharT ch, size_type pos) const noexcept
+{
+    return m_Storage.findOf(&ch, 1, pos, true);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_last_of(const basic_SString8& str, size_type pos) const noexcept
+{
+    const auto [pStr, len] = str.m_Storage.getDataAndSize();
+    return m_Storage.rfindOf(pStr, len, pos, false);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_last_of(const CharT* s, size_type pos, size_type count) const
+{
+    return m_Storage.rfindOf(s, count, pos, false);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_last_of(const CharT* s, size_type pos) const
+{
+    return find_last_of(s, pos, strlen(s));
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_last_of(CharT ch, size_type pos) const noexcept
+{
+    return m_Storage.rfind(ch, pos);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_last_not_of(const basic_SString8& str, size_type pos) const noexcept
+{
+    const auto [pStr, len] = str.m_Storage.getDataAndSize();
+    return m_Storage.rfindOf(pStr, len, pos, true);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_last_not_of(const CharT* s, size_type pos, size_type count) const
+{
+    return m_Storage.rfindOf(s, count, pos, true);
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_last_not_of(const CharT* s, size_type pos) const
+{
+    return find_last_not_of(s, pos, strlen(s));
+}
+
+template<class Alloc>
+typename basic_SString8<Alloc>::size_type basic_SString8<Alloc>::find_last_not_of(CharT ch, size_type pos) const noexcept
+{
+    return m_Storage.rfindOf(&ch, 1, pos, true);
+}
+
+template<class Alloc>
+bool basic_SString8<Alloc>::contains(std::string_view str) const noexcept
+{
+    return m_Storage.find(str.data(), str.size(), 0) != npos;
+}
+
+template<class Alloc>
+bool basic_SString8<Alloc>::contains(CharT ch) const noexcept
+{
+    return m_Storage.find(ch, 0) != npos;
+}
+
+template<class Alloc>
+bool basic_SString8<Alloc>::contains(const CharT* s) const
+{
+    return m_Storage.find(s, strlen(s), 0) != npos;
+}
+
+namespace
+{
+    /**
+    The get area of a streambuf, whose members are protected, so are reached through pointers to them named from a class derived from it.
+    readWord and readLine search the chars already read into it for where they stop and append them all at once, rather than taking a char at a time.
+    */
+    struct GetArea : std::streambuf
     {
-        size_t i = 0;
-        for (const auto ch : ilist)
+        static const char* begin(std::streambuf* pBuf) { return (pBuf->*&GetArea::gptr)(); }
+        static const char* end(std::streambuf* pBuf) { return (pBuf->*&GetArea::egptr)(); }
+        static void bump(std::streambuf* pBuf, size_t count) { (pBuf->*&GetArea::gbump)(static_cast<int>(count)); }
+    };
+}
+
+template<class Alloc>
+std::istream& basic_SString8<Alloc>::readWord(std::istream& is)
+{
+    using Traits = std::char_traits<CharT>;
+    auto state = std::ios_base::goodbit;
+    size_type count = 0;
+    const std::istream::sentry sentry(is);
+    if (sentry)
+    {
+        try
+        {
+            const auto width = is.width();
+            const auto maxCount = (width > 0) ? static_cast<size_type>(width) : std::numeric_limits<size_type>::max();
+            const auto& ctype = std::use_facet<std::ctype<CharT>>(is.getloc());
+            const auto pBuf = is.rdbuf();
+            while (count < maxCount)
+            {
+                const auto ch = pBuf->sgetc();
+                if (Traits::eq_int_type(ch, Traits::eof()))
+                {
+                    state |= std::ios_base::eofbit;
+                    break;
+                }
+                const auto pBegin = GetArea::begin(pBuf);
+                if (pBegin == GetArea::end(pBuf))
+                {
+                    // an unbuffered streambuf, which gives a char at a time
+                    if (ctype.is(std::ctype_base::space, Traits::to_char_type(ch)))
+                        break;
+                    if (count == 0)
+                        clear();
+                    push_back(Traits::to_char_type(ch));
+                    pBuf->sbumpc();
+                    ++count;
+                    continue;
+                }
+                const auto pEnd = pBegin + std::min(static_cast<size_type>(GetArea::end(pBuf) - pBegin), maxCount - count);
+                const auto pSpace = ctype.scan_is(std::ctype_base::space, pBegin, pEnd);
+                const auto len = static_cast<size_type>(pSpace - pBegin);
+                storeSpan(pBegin, len, count == 0);
+                GetArea::bump(pBuf, len);
+                count += len;
+                if (pSpace != pEnd)
+                    break;
+            }
+        }
+        catch (...)
         {
-            oldptr[i] = ch;
-            ++i;
+            state |= std::ios_base::badbit;
         }
-        ASSERT(i == newlen);
-        oldptr[newlen] = '\0';
-        m_Storage.setSize(newlen);
+        is.width(0);
     }
-    else
+    if (count == 0)
+    {
+        if (sentry)
+            clear();
+        state |= std::ios_base::failbit;
+    }
+    if (state != std::ios_base::goodbit)
+        is.setstate(state);
+    return is;
+}
+
+template<class Alloc>
+std::istream& basic_SString8<Alloc>::readLine(std::istream& is, CharT delim)
+{
+    using Traits = std::char_traits<CharT>;
+    auto state = std::ios_base::goodbit;
+    // chars extracted, including the delimiter
+    size_type count = 0;
+    const std::istream::sentry sentry(is, true);
+    if (sentry)
+    {
+        try
+        {
+            const auto pBuf = is.rdbuf();
+            for (;;)
+            {
+                const auto ch = pBuf->sgetc();
+                if (Traits::eq_int_type(ch, Traits::eof()))
+                {
+                    state |= std::ios_base::eofbit;
+                    break;
+                }
+                const auto pBegin = GetArea::begin(pBuf);
+                if (pBegin == GetArea::end(pBuf))
+                {
+                    // an unbuffered streambuf, which gives a char at a time
+                    if (count++ == 0)
+                        clear();
+                    pBuf->sbumpc();
+                    if (Traits::eq(Traits::to_char_type(ch), delim))
+                        break;
+                    push_back(Traits::to_char_type(ch));
+                    continue;
+                }
+                // delim, which isn't stored, ends the line
+                const auto avail = static_cast<size_type>(GetArea::end(pBuf) - pBegin);
+                const auto found = SString8Detail::Search::findChar(pBegin, avail, delim);
+                const auto len = (found == npos) ? avail : found;
+                storeSpan(pBegin, len, count == 0);
+                GetArea::bump(pBuf, (found == npos) ? len : len + 1U);
+                count += (found == npos) ? len : len + 1U;
+                if (found != npos)
+                    break;
+            }
+        }
+        catch (...)
+        {
+            state |= std::ios_base::badbit;
+        }
+    }
+    if (count == 0)
     {
-        m_Storage.allocateWithDeallocate(ilist.begin(), newlen);
+        if (sentry)
+            clear();
+        state |= std::ios_base::failbit;
     }
+    if (state != std::ios_base::goodbit)
+        is.setstate(state);
+    return is;
+}
+
+// the first span replaces the string, so a short word or line is assigned as a whole word, rather than cleared and then appended to
+template<class Alloc>
+void basic_SString8<Alloc>::storeSpan(const CharT* s, size_type count, bool first)
+{
+    if (first)
+        m_Storage.assign(s, count);
+    else
+        m_Storage.append(s, count);
+}
+
+template<class Alloc>
+void basic_SString8<Alloc>::reserve(basic_SString8::size_type new_cap)
+{
+    return m_Storage.reserve(new_cap);
+}
+
+template<class Alloc>
+void basic_SString8<Alloc>::shrink_to_fit()
+{
+    m_Storage.shrinkToFit();
+}
+
+template<class Alloc>
+void basic_SString8<Alloc>::clear(bool releaseMemory) noexcept
+{
+    m_Storage.clear(releaseMemory);
+}
+
+template<class Alloc>
+void basic_SString8<Alloc>::push_back(CharT ch)
+{
+    m_Storage.push_back(ch);
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::append(size_type count, CharT ch)
+{
+    m_Storage.append(count, ch);
     return *this;
 }
 
-const SString8::CharT* SString8::data() const noexcept
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::append(const basic_SString8& str)
 {
-    return m_Storage.data();
+    const auto [ptr, len] = str.m_Storage.getDataAndSize();
+    m_Storage.append(ptr, len);
+    return *this;
 }
 
-SString8::CharT* SString8::data() noexcept
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::append(const basic_SString8& str, size_type pos, size_type count)
 {
-    return m_Storage.data();
+    const auto n = basic_SString8::check_count(str, pos, count);
+    m_Storage.append(str.data() + pos, n);
+    return *this;
 }
 
-SString8::size_type SString8::size() const noexcept
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::append(const CharT* s, size_type count)
 {
-    return m_Storage.size();
+    m_Storage.append(s, count);
+    return *this;
 }
 
-SString8::size_type SString8::length() const noexcept
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::append(const CharT* s)
 {
-    return size();
+    m_Storage.append(s, strlen(s));
+    return *this;
 }
 
-SString8::size_type SString8::capacity() const noexcept
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::append(std::initializer_list<CharT> ilist)
 {
-    return m_Storage.capacity();
+    m_Storage.append(ilist.begin(), ilist.size());
+    return *this;
 }
 
-void SString8::reserve(SString8::size_type new_cap)
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::operator+=(const basic_SString8& str)
 {
-    return m_Storage.reserve(new_cap);
+    return append(str);
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::operator+=(CharT ch)
+{
+    push_back(ch);
+    return *this;
 }
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::operator+=(const CharT* s)
+{
+    return append(s);
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::operator+=(std::initializer_list<CharT> ilist)
+{
+    return append(ilist);
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::insert(size_type index, size_type count, CharT ch)
+{
+    basic_SString8::check_out_of_range(*this, index);
+    m_Storage.insert(index, count, ch);
+    return *this;
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::insert(size_type index, const CharT* s)
+{
+    return insert(index, s, strlen(s));
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::insert(size_type index, const CharT* s, size_type count)
+{
+    basic_SString8::check_out_of_range(*this, index);
+    m_Storage.insert(index, s, count);
+    return *this;
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::insert(size_type index, const basic_SString8& str)
+{
+    const auto [ptr, len] = str.m_Storage.getDataAndSize();
+    return insert(index, ptr, len);
+}
+
+template<class Alloc>
+basic_SString8<Alloc>& basic_SString8<Alloc>::insert(size_type index, const basic_SString8& str, size_type index_str, size_type count)
+{
+    const auto n = basic_SString8::check_count(str, index_str, count);
+    return insert(index, str.data() + index_str, n);
+}
+
+template struct SString8Detail::basic_SString8Data<std::allocator<char>>;
+template struct SString8Detail::basic_SString8Data<SString8PmrAllocator<char>>;
+template struct SString8Detail::basic_SString8Data<SString8SlabAllocator<char>>;
+template class basic_SString8<std::allocator<char>>;
+template class basic_SString8<SString8PmrAllocator<char>>;
+template class basic_SString8<SString8SlabAllocator<char>>;
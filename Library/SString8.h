@@ -7,6 +7,17 @@
 #include <cstdint>
 #include <climits>
 #include <utility>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <atomic>
+
+#include "SString8Search.h"
+
+#if defined(_MSC_VER)
+#include <stdlib.h> // _byteswap_uint64
+#include <intrin.h> // _umul128
+#endif
 
 // assert
 #ifdef _DEBUG
@@ -31,8 +42,46 @@ inline void do_assert(bool expr, const char* expression)
 #define ASSERT(Expr) 
 #endif
 
+// for the few accessors that must be inlined into their callers, which the compiler's heuristics give up on in large functions
+#if defined(_MSC_VER)
+#define SSTRING8_INLINE __forceinline
+#else
+#define SSTRING8_INLINE __attribute__((always_inline)) inline
+#endif
+
 namespace SString8Detail
 {
+    /**
+    The size classes of an allocator: usableSize(bytes) is the number of bytes that a request for bytes actually uses up, so asking for that many instead costs nothing.
+    SString8 asks for the rounded up size and counts the slack as capacity, so that later appends and assignments can use it.
+    Unknown allocators (eg SString8PmrAllocator, whose resource could be anything) are taken to have no slack.
+    The sizes are worked out rather than asked for (eg with malloc_usable_size), as the global operator new may be replaced, and as sized deallocation must be given the size that was allocated.
+    */
+    template<class Alloc>
+    struct AllocatorSizeClasses
+    {
+        static constexpr size_t usableSize(size_t bytes) noexcept { return bytes; }
+    };
+
+    /** Heap allocations through the global operator new, which in practice means malloc */
+    struct MallocSizeClasses
+    {
+        static constexpr size_t usableSize(size_t bytes) noexcept
+        {
+#if defined(__GLIBC__)
+            // glibc chunks are multiples of 16 bytes, at least 32, with 8 bytes of each used by the chunk size
+            const auto chunk = (bytes + 8U + 15U) & ~size_t(15U);
+            return ((chunk < 32U) ? 32U : chunk) - 8U;
+#else
+            // 16 byte granularity, which is the minimum for the Windows heap and most other mallocs on 64 bit
+            return (bytes + 15U) & ~size_t(15U);
+#endif
+        }
+    };
+
+    template<class T>
+    struct AllocatorSizeClasses<std::allocator<T>> : MallocSizeClasses {};
+
     /**
     Abstraction of the SString8 storage.  Not intended to be used in isolation.
     Everything is public because it is assumed that all access (other than for testing) is done through SString8.
@@ -53,6 +102,7 @@ namespace SString8Detail
         If the string is 0 characters then the buffer is all 0.
         If the string is 1->6 characters then there is a null terminator after the last character, and the last byte contains (7-length) in lower nibble (and 0 in upper nibble), and size() returns (7 - last byte).
         If the character is 7 characters then the last byte is 0 (and so length is 7).
+        Any bytes between the null terminator and byte 7 are also 0, so two buffer strings are equal exactly when their 8 byte words are equal.
         Capacity is always 7.
     Small, Medium and Large
         Stores strings 8 characters and longer (excluding null terminator)
@@ -83,9 +133,25 @@ namespace SString8Detail
             The remainder of byte 0 and bytes 1-5 store the address of the string.
             Byte 6 and 7 contain the length. The top bit is always 1 (to indicate heap allocation), so the maximum size that can be stored is 2^15.
             Size is contained in the first 8 bytes of the allocation, and capacity is stored in the second 8 bytes of the allocation.  Thus the string starts at (allocation address)+16
+    Shared payload (when SSTRING8_SHARED_PAYLOAD is defined, for the whole build)
+        Medium and large allocations have an extra 8 bytes in front of the header holding an atomic reference count, and the stored address is that of the header, so the layouts above are unchanged.
+        Copying a medium or large string increments the count and copies the 8 bytes, and the allocation is freed when the last string referring to it goes.
+        Anything that modifies a string whose allocation is shared first copies it into an allocation of its own.
+        Small strings are always copied, as an 8-254 byte copy is about as cheap as the atomic increment and decrement.
+    Borrowed
+        Refers to 8 to 8191 characters (excluding null terminator) owned by someone else, eg a memory mapped file or a string literal, which must stay unchanged for as long as the string refers to them
+        Bits 0 and 1 of byte 0 are 0b11
+        The address (which need not be aligned) is stored shifted left by 2, in bits 2-49, and the length in bits 50-62.
+        Capacity is the length.  There is no heap allocation, so nothing is freed, and copying just copies the 8 bytes.
+        The characters are never written to: anything that modifies the string first copies it into a small, medium or large heap allocation of its own.
     */
-    struct SString8Data
+    template<class Alloc>
+    struct basic_SString8Data
     {
+        // heap allocations are made with a default constructed Alloc, so every Alloc must be able to free what any other allocated
+        static_assert(std::is_same_v<typename std::allocator_traits<Alloc>::value_type, char>);
+        static_assert(std::allocator_traits<Alloc>::is_always_equal::value);
+
         // Only little endian is supported.  Comment this line out if your compiling at below c++20 and you are confident that your system is little endian
         static_assert(std::endian::native == std::endian::little);
         // Only 64 bit systems are supported.  32 bit is possible but there's probably not much point.  128 bit systems are not common (yet) - will cross that bridge when the time comes
@@ -107,12 +173,13 @@ namespace SString8Detail
                 uintptr_t m_pLargeStr;
                 Buffer m_Buffer;
             };
-            inline Storage()
-                : m_Buffer{ 0,0,0,0,0,0,0,'\7' }
+            // the empty buffer: all 0 apart from byte 7, which holds 7 - 0.  Set as the word so that it is the active member at compile time
+            constexpr Storage()
+                : m_pLargeStr(7ULL << 56U)
             {}
-            static_assert(sizeof uintptr_t == sizeof Buffer); // make sure that we aren't accidently introducing some padding
+            static_assert(sizeof(uintptr_t) == sizeof(Buffer)); // make sure that we aren't accidently introducing some padding
         } m_Storage;
-        static_assert(sizeof uintptr_t == sizeof m_Storage); // make sure that we aren't accidently introducing some padding
+        static_assert(sizeof(uintptr_t) == sizeof(m_Storage)); // make sure that we aren't accidently introducing some padding
 
         static inline constexpr auto top = 1ULL << 63U;
         static inline constexpr auto notTop = ~top;
@@ -122,8 +189,17 @@ namespace SString8Detail
         static inline constexpr auto small_bits = top | small_lower_bits;
         static inline constexpr auto medium_bits = top | medium_lower_bits;
         static inline constexpr auto large_bits = top | large_lower_bits;
+        static inline constexpr auto borrowed_lower_bits = 0b11ULL;
+        static inline constexpr auto borrowed_bits = top | borrowed_lower_bits;
+        static inline constexpr auto borrowed_address_bits = (1ULL << 48U) - 1U;
+        static inline constexpr auto max_size_borrowed = 0x1FFFULL;
         static inline constexpr auto fifeteen_bites_set = 0x7FFFULL;
         static inline constexpr auto max_size_small = 254ULL;
+#if defined(SSTRING8_SHARED_PAYLOAD)
+        static inline constexpr bool shared_payload = true;
+#else
+        static inline constexpr bool shared_payload = false;
+#endif
 
         static inline constexpr auto lowest_two_bits_zero = ~0b11ULL;
         static inline constexpr auto not_top_two_bytes_or_bottom_two_bits = 0x00ULL
@@ -144,27 +220,126 @@ namespace SString8Detail
             return desired_cap;
         }
 
+        /**
+        The capacity to allocate for at least cap chars (already made even by calcCapacity if small).
+        The allocation is rounded up to Alloc's size class, and the capacity takes up the slack, keeping within cap's tier (and keeping small capacities even)
+        */
+        static constexpr size_t usableCapacity(size_t cap) noexcept
+        {
+            const auto header = headerSize(cap);
+            const auto usable = AllocatorSizeClasses<Alloc>::usableSize(header + cap + 1U) - header - 1U;
+            if (cap <= max_size_small)
+            {
+                const auto even = usable & ~size_t(1U);
+                return (even < max_size_small) ? even : max_size_small;
+            }
+            if (cap <= fifeteen_bites_set)
+                return (usable < fifeteen_bites_set) ? usable : fifeteen_bites_set;
+            return usable;
+        }
+
+        /** Bytes in front of the header in a heap allocation of this capacity: the reference count for a shared medium or large allocation, otherwise none */
+        static constexpr size_t refCountSize(size_t cap) noexcept
+        {
+            return (shared_payload && cap > max_size_small) ? 8U : 0U;
+        }
+
+        /** Bytes in front of the string in a heap allocation of this capacity: none for small, the capacity for medium, and the size and capacity for large (plus any reference count) */
+        static constexpr size_t headerSize(size_t cap) noexcept
+        {
+            return refCountSize(cap) + ((cap <= max_size_small) ? 0U : (cap <= fifeteen_bites_set) ? 8U : 16U);
+        }
+
+        /**
+        Capacity to grow to when at least required chars are needed and old_cap is not enough.
+        Doubles, so that appending N chars one at a time costs amortised O(N) with O(log N) allocations.
+        The result is then pushed up so that the whole allocation (header + string + null terminator) fills a 16 byte malloc size class,
+        keeping within the tier that the doubled capacity falls in (and keeping small capacities even).
+        */
+        static size_t calcGrowthCapacity(size_t old_cap, size_t required) noexcept
+        {
+            auto cap = (required > 2 * old_cap) ? required : 2 * old_cap;
+            constexpr auto roundUp16 = [](size_t n) { return (n + 15U) & ~size_t(15U); };
+            if (cap <= max_size_small)
+            {
+                // the largest even capacity for which cap + null terminator fits in the size class
+                cap = roundUp16(cap + 2U) - 2U;
+                return (cap < max_size_small) ? cap : max_size_small;
+            }
+            const auto header = headerSize(cap);
+            cap = roundUp16(cap + header + 1U) - header - 1U;
+            if (header == 8U && cap > fifeteen_bites_set)
+                return fifeteen_bites_set;
+            return cap;
+        }
+
         // highest bit is 1 if it is a pointer, 0 if it is a buffer
         inline bool isPtr() const noexcept
         {
             return (m_Storage.m_pLargeStr & top) != 0;
         }
-        enum class StorageType { BUFFER, SMALL, MEDIUM, LARGE };
+        // the heap types are numbered so that they are (1 + the lowest two bits)
+        enum class StorageType { BUFFER, SMALL, MEDIUM, LARGE, BORROWED };
+        static_assert(static_cast<uint64_t>(StorageType::SMALL) == 1 + small_lower_bits);
+        static_assert(static_cast<uint64_t>(StorageType::MEDIUM) == 1 + medium_lower_bits);
+        static_assert(static_cast<uint64_t>(StorageType::LARGE) == 1 + large_lower_bits);
+        static_assert(static_cast<uint64_t>(StorageType::BORROWED) == 1 + borrowed_lower_bits);
         inline bool isBuffer() const noexcept { return !isPtr(); }
         inline bool isSmall()  const noexcept { return isPtr() && (m_Storage.m_pLargeStr & 0b11) == small_lower_bits; }
         inline bool isMedium() const noexcept { return isPtr() && (m_Storage.m_pLargeStr & 0b11) == medium_lower_bits; }
         inline bool isLarge()  const noexcept { return isPtr() && (m_Storage.m_pLargeStr & 0b11) == large_lower_bits; }
-        [[nodiscard]] StorageType getStorageType() const
+        inline bool isBorrowed() const noexcept { return isPtr() && (m_Storage.m_pLargeStr & 0b11) == borrowed_lower_bits; }
+        // a heap allocation that this string owns, and so frees
+        inline bool isOwnedPtr() const noexcept { return isPtr() && (m_Storage.m_pLargeStr & 0b11) != borrowed_lower_bits; }
+        // a medium or large allocation, which has a reference count when shared_payload is set
+        inline bool isShareable() const noexcept
+        {
+            return shared_payload && isPtr() && ((m_Storage.m_pLargeStr & 0b11) == medium_lower_bits || (m_Storage.m_pLargeStr & 0b11) == large_lower_bits);
+        }
+        [[nodiscard]] StorageType getStorageType() const noexcept
         {
-            // @todo speed this up
             if (isBuffer())
                 return StorageType::BUFFER;
-            if (isSmall())
-                return StorageType::SMALL;
-            if (isMedium())
-                return StorageType::MEDIUM;
-            ASSERT(isLarge());
-            return StorageType::LARGE;
+            return static_cast<StorageType>(1U + (m_Storage.m_pLargeStr & 0b11));
+        }
+
+        /** Everything needed to read or write the string, obtained from one pass over the 8 byte storage word */
+        struct Decoded
+        {
+            char* m_pData;
+            size_t m_Size;
+            size_t m_Capacity;
+            StorageType m_Type;
+        };
+
+        /**
+        Work out the data pointer, size and capacity together.
+        The top bit picks buffer vs heap, and for the heap the lowest two bits pick the layout, so the word is only examined once rather than by a chain of isPtr/isSmall/isMedium tests.
+        Small and borrowed read everything from the word, medium reads the capacity from the heap header and large reads both from the heap header.
+        */
+        [[nodiscard]] inline Decoded decode() const noexcept
+        {
+            const auto word = m_Storage.m_pLargeStr;
+            if ((word & top) == 0)
+                return { const_cast<char*>(m_Storage.m_Buffer.m_Buffer), 7U - (word >> 56U), 7U, StorageType::BUFFER };
+
+            const auto pAlloc = reinterpret_cast<char*>(word & not_top_two_bytes_or_bottom_two_bits);
+            const auto lowerBits = word & 0b11;
+            if (lowerBits == small_lower_bits)
+                return { pAlloc, (word >> 48U) & 0xFFU, ((word >> 56U) & 0x7FU) << 1U, StorageType::SMALL };
+            if (lowerBits == borrowed_lower_bits)
+            {
+                const auto sz = (word >> 50U) & max_size_borrowed;
+                return { reinterpret_cast<char*>((word >> 2U) & borrowed_address_bits), sz, sz, StorageType::BORROWED };
+            }
+
+            // medium and large: the string follows an 8 or 16 byte header, ie 8 * the lower bits
+            const auto pHeader = reinterpret_cast<const uint64_t*>(pAlloc);
+            const auto pData = pAlloc + (lowerBits << 3U);
+            if (lowerBits == medium_lower_bits)
+                return { pData, (word >> 48U) & fifeteen_bites_set, pHeader[0], StorageType::MEDIUM };
+            ASSERT(lowerBits == large_lower_bits);
+            return { pData, pHeader[0], pHeader[1], StorageType::LARGE };
         }
 
         // highest bit is 1 if it is a pointer, 0 if it is a buffer
@@ -196,6 +371,13 @@ namespace SString8Detail
             *pCap = cap;
             m_Storage.m_pLargeStr |= large_bits;
         }
+        inline void setBorrowed(const char* p, size_t len) noexcept
+        {
+            const auto address = reinterpret_cast<uintptr_t>(p);
+            ASSERT(address <= borrowed_address_bits);
+            ASSERT(len <= max_size_borrowed);
+            m_Storage.m_pLargeStr = borrowed_bits | (static_cast<uint64_t>(len) << 50U) | (static_cast<uint64_t>(address) << 2U);
+        }
 
         // strip out the top bit and the lowest 2 bits
         inline       char* getAsPtr()       noexcept
@@ -207,51 +389,47 @@ namespace SString8Detail
             return reinterpret_cast<const char*>(m_Storage.m_pLargeStr & not_top_two_bytes_or_bottom_two_bits);
         }
 
-        inline void swap(SString8Data& rhs) noexcept
+        constexpr void swap(basic_SString8Data& rhs) noexcept
         {
             std::swap(m_Storage.m_pLargeStr, rhs.m_Storage.m_pLargeStr);
         }
 
-        size_t size() const noexcept
+        constexpr size_t size() const noexcept
         {
-            switch (getStorageType())
-            {
-            case StorageType::BUFFER:
-                return 7 - m_Storage.m_Buffer.m_Buffer[7]; // std::find ?
-            case StorageType::SMALL:
-                return *reinterpret_cast<const uint8_t*>(&m_Storage.m_Buffer.m_Buffer[6]);
-            case StorageType::MEDIUM:
-                return *reinterpret_cast<const uint16_t*>(&m_Storage.m_Buffer.m_Buffer[6]) & ~(1U << 15U); // remove the top bit
-            case StorageType::LARGE:
-                auto ptr = getAsPtr();
-                auto pLen = reinterpret_cast<const uint64_t*>(reinterpret_cast<const char*>(ptr));
-                return *pLen;
-            }
-            ASSERT(false);
-            return 0;
+            // the buffer needs nothing but the word, which also makes this usable at compile time
+            const auto word = m_Storage.m_pLargeStr;
+            if ((word & top) == 0)
+                return 7U - (word >> 56U);
+            return getHeapDataAndSize().second;
         }
 
         // assumes that it is already in the correct size format
         void setSize(size_t sz) noexcept
         {
-            switch (getStorageType())
+            setSize(sz, getStorageType());
+        }
+
+        // as setSize(sz), for when the storage type is already known (eg from decode())
+        void setSize(size_t sz, StorageType type) noexcept
+        {
+            switch (type)
             {
             case StorageType::BUFFER:
             {
                 ASSERT(sz <= 7);
-                m_Storage.m_Buffer.m_Buffer[7] = static_cast<char>(7 - sz);
+                // also zero the null terminator and anything left over after it from a longer string
+                m_Storage.m_pLargeStr = (m_Storage.m_pLargeStr & ((1ULL << (8U * sz)) - 1U)) | (static_cast<uint64_t>(7U - sz) << 56U);
                 break;
             }
+            // small and medium update the whole word rather than storing to bytes 6 and 7, so that the next read of the word isn't stalled waiting for a partial store
             case StorageType::SMALL:
             {
-                auto pLen = reinterpret_cast<uint8_t*>(&m_Storage.m_Buffer.m_Buffer[6]);
-                *pLen = static_cast<uint8_t>(sz);
+                m_Storage.m_pLargeStr = (m_Storage.m_pLargeStr & ~(0xFFULL << 48U)) | (static_cast<uint64_t>(static_cast<uint8_t>(sz)) << 48U);
                 break;
             }
             case StorageType::MEDIUM:
             {
-                auto pLen = reinterpret_cast<uint16_t*>(&m_Storage.m_Buffer.m_Buffer[6]);
-                *pLen = static_cast<uint16_t>(sz | (1U << 15U));
+                m_Storage.m_pLargeStr = (m_Storage.m_pLargeStr & ~(fifeteen_bites_set << 48U)) | (static_cast<uint64_t>(sz & fifeteen_bites_set) << 48U);
                 break;
             }
             case StorageType::LARGE:
@@ -268,111 +446,207 @@ namespace SString8Detail
 
         size_t capacity() const noexcept
         {
-            switch (getStorageType())
-            {
-            case StorageType::BUFFER:
+            return decode().m_Capacity;
+        }
+
+        std::pair<size_t, size_t> getSizeAndCap() const noexcept
+        {
+            const auto decoded = decode();
+            return { decoded.m_Size, decoded.m_Capacity };
+        }
+
+        std::pair<char*, size_t> getDataAndSize() noexcept
+        {
+            const auto decoded = decode();
+            return { decoded.m_pData, decoded.m_Size };
+        }
+
+        /**
+        As getDataAndSize, for a heap string, with small strings - the commonest heap tier, and the one whose searches are over soonest - read straight from the word.
+        Forced inline, as the compiler won't inline getDataAndSize into large functions, and the call costs as much as searching (or reading the size of) a small string.
+        */
+        SSTRING8_INLINE std::pair<const char*, size_t> getHeapDataAndSize() const noexcept
+        {
+            const auto word = m_Storage.m_pLargeStr;
+            if ((word & 0b11) == small_lower_bits)
+                return { reinterpret_cast<const char*>(word & not_top_two_bytes_or_bottom_two_bits), (word >> 48U) & 0xFFU };
+            return getDataAndSize();
+        }
+
+        std::pair<char*, size_t> getDataAndCap() noexcept
+        {
+            const auto decoded = decode();
+            return { decoded.m_pData, decoded.m_Capacity };
+        }
+
+        /** As decode, without the capacity, which a medium or large string would have to read from its header */
+        std::pair<const char*, size_t> getDataAndSize() const noexcept
+        {
+            const auto word = m_Storage.m_pLargeStr;
+            if ((word & top) == 0)
+                return { m_Storage.m_Buffer.m_Buffer, 7U - (word >> 56U) };
+
+            const auto pAlloc = reinterpret_cast<const char*>(word & not_top_two_bytes_or_bottom_two_bits);
+            const auto lowerBits = word & 0b11;
+            if (lowerBits == small_lower_bits)
+                return { pAlloc, (word >> 48U) & 0xFFU };
+            if (lowerBits == borrowed_lower_bits)
+                return { reinterpret_cast<const char*>((word >> 2U) & borrowed_address_bits), (word >> 50U) & max_size_borrowed };
+            if (lowerBits == medium_lower_bits)
+                return { pAlloc + 8U, (word >> 48U) & fifeteen_bites_set };
+            return { pAlloc + 16U, *reinterpret_cast<const uint64_t*>(pAlloc) };
+        }
+
+        inline char* data() noexcept
+        {
+            return decode().m_pData;
+        }
+
+        inline const char* data() const noexcept
+        {
+            return decode().m_pData;
+        }
+
+        constexpr basic_SString8Data() = default;
+
+        constexpr basic_SString8Data(const basic_SString8Data& rhs) // test - SString8DataTestConstructorCopy
+        {
+            if (std::is_constant_evaluated())
             {
-                return 7;
+                // only buffer strings can be made at compile time
+                m_Storage.m_pLargeStr = rhs.m_Storage.m_pLargeStr;
+                return;
             }
-            case StorageType::SMALL:
+            if (rhs.isBorrowed())
             {
-                size_t sz = (*reinterpret_cast<const uint8_t*>(&m_Storage.m_Buffer.m_Buffer[7])) & ~(1U << 7U); // remove the top bit
-                return sz << 1U; // its an even number stored shifted right 1 to make room for the ptr indicator
+                // nothing is owned, so the copy can refer to the same chars
+                m_Storage.m_pLargeStr = rhs.m_Storage.m_pLargeStr;
+                return;
             }
-            case StorageType::MEDIUM:
+            if (rhs.isShareable())
             {
-                const auto ptr = getAsPtr();
-                auto uintPtr = reinterpret_cast<const uint64_t*>(reinterpret_cast<const char*>(ptr));
-                return *uintPtr;
+                rhs.refCount().fetch_add(1, std::memory_order_relaxed);
+                m_Storage.m_pLargeStr = rhs.m_Storage.m_pLargeStr;
+                return;
             }
-            case StorageType::LARGE:
+            const auto [pRhs, len] = rhs.getDataAndSize();
+            allocate(pRhs, len);
+        }
+
+        /** Copies into the existing allocation when it is big enough (and not borrowed or shared), so assigning to a reused string doesn't allocate */
+        basic_SString8Data& operator=(const basic_SString8Data& rhs) // test - SString8DataTestAssignement
+        {
+            if (this == &rhs)
+                return *this;
+            if (rhs.isBorrowed() || rhs.isShareable())
             {
-                auto ptr = getAsPtr();
-                auto pCap = reinterpret_cast<const uint64_t*>(8U + reinterpret_cast<const char*>(ptr));
-                return *pCap;
+                // the copy constructor shares these in O(1)
+                basic_SString8Data copy(rhs);
+                swap(copy);
+                return *this;
             }
-            }
-            ASSERT(false);
-            return 0;
+            const auto [pRhs, len] = rhs.getDataAndSize();
+            assign(pRhs, len);
+            return *this;
         }
 
-        std::pair<size_t, size_t> getSizeAndCap() const
+        basic_SString8Data& operator=(basic_SString8Data&& rhs) noexcept // test - SString8DataTestAssignementMove
         {
-            return { size(), capacity() }; // @todo - speed this up to avoid multiple calls to isSmall etc
+            swap(rhs);
+            return *this;
         }
 
-        std::pair<char*, size_t> getDataAndSize()
+        constexpr basic_SString8Data(basic_SString8Data&& rhs) noexcept // test - SString8DataTestConstructorMove
         {
-            return { data(), size() }; // @todo - speed this up to avoid multiple calls to isSmall etc
+            swap(rhs);
         }
 
-        std::pair<char*, size_t> getDataAndCap()
+        constexpr ~basic_SString8Data() noexcept
         {
-            return { data(), capacity() }; // @todo - speed this up to avoid multiple calls to isSmall etc
+            // nothing is allocated at compile time
+            if (!std::is_constant_evaluated())
+                deallocate();
         }
 
-        std::pair<const char*, size_t> getDataAndSize() const
+        constexpr basic_SString8Data(std::string_view rhs) // test - SString8DataTestConstructorStringView
+            : basic_SString8Data(rhs.data(), rhs.size())
         {
-            return { data(), size() }; // @todo - speed this up to avoid multiple calls to isSmall etc
         }
 
-        inline char* data() noexcept
+        /** Bytes in the heap allocation for this capacity: the header, the string and the null terminator */
+        static constexpr size_t allocationSize(size_t cap) noexcept
         {
-            if (isBuffer())
-                return m_Storage.m_Buffer.m_Buffer;
-            if (isSmall())
-                return getAsPtr();
-            if (isMedium())
-                return 8U + getAsPtr();
-            return 16U + getAsPtr();
+            return headerSize(cap) + cap + 1;
         }
 
-        inline const char* data() const noexcept
+        /** All heap allocation goes through Alloc, which is stateless, so one is made as needed */
+        static char* allocateBytes(size_t bytes)
         {
-            if (isBuffer())
-                return m_Storage.m_Buffer.m_Buffer;
-            if (isSmall())
-                return getAsPtr();
-            if (isMedium())
-                return 8U + getAsPtr();
-            return 16U + getAsPtr();
+            Alloc alloc;
+            return std::allocator_traits<Alloc>::allocate(alloc, bytes);
         }
 
-        SString8Data() = default;
-
-        SString8Data(const SString8Data& rhs) // test - SString8DataTestConstructorCopy
-            : SString8Data(rhs.data(), rhs.size())
+        static void deallocateBytes(char* ptr, size_t bytes) noexcept
         {
+            Alloc alloc;
+            std::allocator_traits<Alloc>::deallocate(alloc, ptr, bytes);
         }
 
-        SString8Data& operator=(SString8Data rhs) noexcept // test - SString8DataTestAssignement
+        /** The reference count in front of the header of a shared medium or large allocation */
+        std::atomic_ref<uint64_t> refCount() const noexcept
         {
-            swap(rhs);
-            return *this;
+            ASSERT(isShareable());
+            return std::atomic_ref<uint64_t>(*reinterpret_cast<uint64_t*>(const_cast<char*>(getAsPtr()) - 8U));
         }
 
-        SString8Data(SString8Data&& rhs) noexcept // test - SString8DataTestConstructorMove
+        /** Whether no other string shares this allocation (always true unless it is shareable) */
+        bool isUnshared() const noexcept
         {
-            swap(rhs);
+            return !isShareable() || refCount().load(std::memory_order_acquire) == 1U;
         }
 
-        ~SString8Data() noexcept
+        /**
+        Allocate for this capacity, with the reference count (if any) set to 1.
+        Returns the address to store in the word, which is that of the header, and so refCountSize(cap) bytes into the allocation
+        */
+        static char* allocateHeap(size_t cap)
         {
-            if (isPtr())
-                delete[] getAsPtr();
+            auto ptr = allocateBytes(allocationSize(cap));
+            if (refCountSize(cap) != 0)
+            {
+                const uint64_t one = 1;
+                memcpy(ptr, &one, sizeof(one));
+            }
+            return ptr + refCountSize(cap);
         }
 
-        SString8Data(std::string_view rhs) // test - SString8DataTestConstructorStringView
-            : SString8Data(rhs.data(), rhs.size())
+        /** Free the heap allocation, if there is one (a borrowed string has none) and no other string shares it.  Leaves the storage word as it is */
+        void deallocate() noexcept
         {
+            if (!isOwnedPtr())
+                return;
+            // acq_rel so that the last owner sees everything the others did before letting go
+            if (isShareable() && refCount().fetch_sub(1, std::memory_order_acq_rel) != 1U)
+                return;
+            const auto cap = capacity();
+            deallocateBytes(getAsPtr() - refCountSize(cap), allocationSize(cap));
         }
 
-        /** Assumes that we are doing a heap allocation not a buffer storage. Does not deallocate */
+        /** Assumes that we are doing a heap allocation not a buffer storage.  The capacity is rounded up to fill Alloc's size class (see usableCapacity).  Does not deallocate */
         void allocatePtr(const char* pRhs, size_t len, size_t cap)
         {
-            const auto offset = (cap <= max_size_small) ? 0U : (cap <= fifeteen_bites_set) ? 8U : 16U;
-            auto ptr = new char[cap + offset + 1];
-            strncpy_s(ptr + offset, len + 1, pRhs, len);
+            // an empty string_view or initializer list may have a null pRhs, which memcpy isn't given even with a length of 0
+            allocatePtrWith(len, cap, [pRhs, len](char* pDest) { if (len != 0) memcpy(pDest, pRhs, len); });
+        }
+
+        /** A heap allocation of (at least) cap, holding the len chars written by write(char* pDest) */
+        template<class Write>
+        void allocatePtrWith(size_t len, size_t cap, Write&& write)
+        {
+            cap = usableCapacity(cap);
+            const auto offset = headerSize(cap) - refCountSize(cap);
+            auto ptr = allocateHeap(cap);
+            write(ptr + offset);
             ptr[len + offset] = '\0';
             m_Storage.m_pLargeStr = reinterpret_cast<uintptr_t>(ptr);
             if (cap <= max_size_small)
@@ -387,8 +661,9 @@ namespace SString8Detail
         {
             if (len <= 7)
             {
-                strncpy(m_Storage.m_Buffer.m_Buffer, pRhs, len);
-                m_Storage.m_Buffer.m_Buffer[len] = '\0';
+                m_Storage.m_pLargeStr = 0; // may previously have been a pointer
+                if (len != 0)
+                    memcpy(m_Storage.m_Buffer.m_Buffer, pRhs, len);
                 m_Storage.m_Buffer.m_Buffer[7] = static_cast<char>(7 - len);
             }
             else
@@ -400,180 +675,1158 @@ namespace SString8Detail
 
         void allocateWithDeallocate(const char* pRhs, size_t len)
         {
-            if (isPtr())
-                delete[] getAsPtr();
+            deallocate();
             allocate(pRhs, len);
         }
 
+        /**
+        Refer to the len chars at pRhs without copying them.  pRhs[len] must be a null terminator, and the chars must outlive this string (and all copies of it) unchanged.
+        Strings short enough for the buffer, or too long to borrow, are copied as usual.  Does not deallocate
+        */
+        void borrow(const char* pRhs, size_t len)
+        {
+            if (len <= 7 || len > max_size_borrowed)
+            {
+                allocate(pRhs, len);
+                return;
+            }
+            ASSERT(pRhs[len] == '\0');
+            setBorrowed(pRhs, len);
+        }
+
+        /** Copy a borrowed string, or one sharing its allocation, into a heap allocation of its own (of the same capacity), so that it can be written to.  Does nothing to any other string */
+        void makeWritable()
+        {
+            const auto decoded = decode();
+            if (fitsInPlace(decoded, decoded.m_Size))
+                return;
+            basic_SString8Data owned;
+            owned.allocatePtr(decoded.m_pData, decoded.m_Size, calcCapacity(decoded.m_Capacity));
+            swap(owned);
+        }
+
+        /** Whether newSize chars can be written without a new allocation.  Borrowed chars can't be written to, and nor can an allocation shared with other strings */
+        inline bool fitsInPlace(const Decoded& decoded, size_t newSize) const noexcept
+        {
+            return newSize <= decoded.m_Capacity && decoded.m_Type != StorageType::BORROWED && isUnshared();
+        }
+
+        /** Capacity for newSize chars when they don't fit in place: geometric growth if the capacity is too small, otherwise (for a borrowed or shared string) the same capacity */
+        static inline size_t calcCopyCapacity(const Decoded& decoded, size_t newSize) noexcept
+        {
+            if (newSize <= decoded.m_Capacity)
+                return calcCapacity(decoded.m_Capacity);
+            return calcGrowthCapacity(decoded.m_Capacity, newSize);
+        }
+
         /**
         Assumes that len is the number of chars pointed to by pRhs, not including any null terminator.
         If this is not true then bad things will happen.
         Null terminator not required.
+        At compile time only the buffer is available, so a constant of more than 7 chars fails to compile.
         */
-        SString8Data(const char* pRhs, size_t len)
+        constexpr basic_SString8Data(const char* pRhs, size_t len)
         {
+            if (std::is_constant_evaluated() && len <= 7)
+            {
+                m_Storage.m_pLargeStr = constantBufferWord(pRhs, len);
+                return;
+            }
             allocate(pRhs, len);
         }
 
+        /** makeBufferWord for compile time, a char at a time */
+        static constexpr uint64_t constantBufferWord(const char* p, size_t len) noexcept
+        {
+            uint64_t word = static_cast<uint64_t>(7U - len) << 56U;
+            for (size_t i = 0; i < len; ++i)
+                word |= static_cast<uint64_t>(static_cast<uint8_t>(p[i])) << (8U * i);
+            return word;
+        }
+
         /** if the requested amount is bigger than what is currently available, then do a heap allocation to the new capacity, copying across and then deleting the old string */
         void reserve(size_t new_cap)
         {
-            if (new_cap <= capacity())
+            const auto decoded = decode();
+            if (new_cap <= decoded.m_Capacity)
                 return;
             // small strings get an even capacity
             new_cap = calcCapacity(new_cap);
 
-            auto oldPtr = getAsPtr();
-            const auto bWasPtr = isPtr();
-            auto [pOld, sz] = getDataAndSize();
-            allocatePtr(pOld, sz, new_cap);
-            if (bWasPtr)
-                delete[] oldPtr;
+            // the old storage is released as grown goes out of scope, which frees it unless it is borrowed or still shared
+            basic_SString8Data grown;
+            grown.allocatePtr(decoded.m_pData, decoded.m_Size, new_cap);
+            swap(grown);
         }
 
-        /** Allocate enough space for count+1 (including potentially even capacity and the null terminator)
-           then write in count copies of ch, and null terminate */
-        SString8Data(size_t count, char ch);
-    };
-} // namespace detail
-
-#include <cstddef>
-#include <string>
-#include <stdexcept>
-#include <ostream>
-#include <initializer_list>
-#include <type_traits>
-
-/**
-An alternative to std::string which is only 8 bytes in size as opposed to the usual 24-32 bytes.
-Only valid on a 64 bit  system.
-Otimised for very short strings - has a 7 byte buffer (as opposed to the more usual 15 or 23)
-It does support the full range of string sizes, but once the string is bigger than 254 bytes it will be less performant than a std::string (though still smaller)
-No documentation as it is the same as std::string
-*/
-class SString8
-{
-public:
-    using size_type = size_t;
-    using CharT = char;
-
-    // constructors
-
-    SString8(std::nullptr_t) = delete;
+        /**
+        Move to the smallest storage that holds the string: the buffer if it is 7 chars or fewer, otherwise a heap allocation of just enough capacity (rounded up to the size class), in whichever tier that falls.
+        Borrowed strings have no allocation to shrink, and a shared allocation is left alone, as a copy would only add to the memory used.
+        */
+        void shrinkToFit() // test - SString8DataTestShrinkToFit
+        {
+            const auto decoded = decode();
+            if (decoded.m_Type == StorageType::BUFFER || decoded.m_Type == StorageType::BORROWED || !isUnshared())
+                return;
+            if (decoded.m_Size > 7 && usableCapacity(calcCapacity(decoded.m_Size)) == decoded.m_Capacity)
+                return;
+            basic_SString8Data shrunk(decoded.m_pData, decoded.m_Size);
+            swap(shrunk);
+        }
 
-    SString8() noexcept = default; // test - String8TestDefaultConstructor
+        /** Make the string empty.  If release is false then the capacity is kept (unless it is borrowed or shared), otherwise any allocation is let go, leaving an empty buffer */
+        void clear(bool release) noexcept // test - SString8DataTestClear
+        {
+            const auto decoded = decode();
+            if (!release && fitsInPlace(decoded, 0))
+            {
+                decoded.m_pData[0] = '\0';
+                setSize(0, decoded.m_Type);
+                return;
+            }
+            deallocate();
+            m_Storage = Storage();
+        }
 
-    SString8(std::string_view str); // test - String8TestConstructorStringView
-    SString8(const std::string& str); // test - String8TestConstructorString
-    operator std::string_view() const; // test - String8Testoperatotstdstringview
+        static constexpr uint64_t byteSwap(uint64_t word) noexcept
+        {
+#if defined(__cpp_lib_byteswap)
+            return std::byteswap(word);
+#elif defined(_MSC_VER)
+            if (std::is_constant_evaluated())
+            {
+                uint64_t swapped = 0;
+                for (int i = 0; i < 8; ++i)
+                    swapped |= ((word >> (8 * i)) & 0xFFU) << (8 * (7 - i));
+                return swapped;
+            }
+            return _byteswap_uint64(word);
+#else
+            return __builtin_bswap64(word);
+#endif
+        }
 
-    SString8(size_type count, CharT ch); // test - String8TestConstructorCountChar
+        /**
+        For a buffer string: the chars as a big endian number, with the size in place of byte 7.
+        Because the bytes after the string are 0, unsigned comparison of two keys orders the strings lexicographically
+        (with the size breaking ties between eg "ab" and "ab\0").
+        */
+        static constexpr uint64_t bufferOrderKey(uint64_t word) noexcept
+        {
+            return (byteSwap(word) & ~0xFFULL) | (7U - (word >> 56U));
+        }
 
-    SString8(const SString8& other, size_type pos); // test - String8TestConstructorOtherPos
-    SString8(const std::string& other, size_type pos); // test - String8TestConstructorOtherPos
+        /**
+        The first 8 chars as a big endian number, with 0s after the end of a shorter string, for any tier.
+        Unsigned comparison of two keys orders the strings by their first 8 chars; strings with the same key need a full comparison (see sort_sstring8).
+        */
+        inline uint64_t prefixKey() const noexcept
+        {
+            const auto word = m_Storage.m_pLargeStr;
+            if ((word & top) == 0)
+                return byteSwap(word) & ~0xFFULL;
+            const auto [pData, len] = getDataAndSize();
+            uint64_t chars = 0;
+            if (len >= sizeof(chars))
+                memcpy(&chars, pData, sizeof(chars));
+            else
+                memcpy(&chars, pData, len);
+            return byteSwap(chars);
+        }
 
-    SString8(const SString8& other, size_type pos, size_type count); // test - String8TestConstructorOtherPosCount
-    SString8(const std::string& other, size_type pos, size_type count); // test - String8TestConstructorOtherPosCount
+        /** Compare the held strings.  Two buffer strings compare as single words (at compile time too), otherwise it is a length check (for equality) and memcmp, so embedded nulls are handled */
+        static constexpr bool equals(const basic_SString8Data& lhs, const basic_SString8Data& rhs) noexcept
+        {
+            const auto lhsWord = lhs.m_Storage.m_pLargeStr;
+            const auto rhsWord = rhs.m_Storage.m_pLargeStr;
+            // the same word is the same chars, including for copies sharing a borrowed or shared payload (eg strings from SString8InternPool)
+            if (lhsWord == rhsWord)
+                return true;
+            if (((lhsWord | rhsWord) & top) == 0)
+                return false;
+            // a heap string can still be 7 chars or fewer (eg after reserve), so a buffer and a heap string may be equal
+            const auto lhsDecoded = lhs.decode();
+            const auto rhsDecoded = rhs.decode();
+            return lhsDecoded.m_Size == rhsDecoded.m_Size
+                && 0 == memcmp(lhsDecoded.m_pData, rhsDecoded.m_pData, lhsDecoded.m_Size);
+        }
 
-    SString8(const CharT* s, size_type count); // test - String8TestConstructorCharStarCount
+        /** <0, 0 or >0, as for std::string::compare */
+        static constexpr int compare(const basic_SString8Data& lhs, const basic_SString8Data& rhs) noexcept
+        {
+            const auto lhsWord = lhs.m_Storage.m_pLargeStr;
+            const auto rhsWord = rhs.m_Storage.m_pLargeStr;
+            if (((lhsWord | rhsWord) & top) == 0)
+            {
+                const auto lhsKey = bufferOrderKey(lhsWord);
+                const auto rhsKey = bufferOrderKey(rhsWord);
+                return (lhsKey > rhsKey) - (lhsKey < rhsKey);
+            }
+            const auto rhsDecoded = rhs.decode();
+            return lhs.compare(rhsDecoded.m_pData, rhsDecoded.m_Size);
+        }
 
-    SString8(const CharT* s); // test - String8TestConstructorCharStar
+        /** Compare with len chars at pRhs, <0, 0 or >0 as for std::string::compare */
+        inline int compare(const char* pRhs, size_t len) const noexcept
+        {
+            const auto decoded = decode();
+            const auto common = (decoded.m_Size < len) ? decoded.m_Size : len;
+            const auto cmp = memcmp(decoded.m_pData, pRhs, common);
+            if (cmp != 0)
+                return cmp;
+            return (decoded.m_Size > len) - (decoded.m_Size < len);
+        }
 
-    template<class InputIt>
-    SString8(InputIt first, InputIt last) // test - String8TestConstructorInputItFirstLast
-    {
-        std::string tempstdstr(first, last);
-        auto tempstr = SString8(tempstdstr);
-        swap(tempstr);
-    }
+        /** Equality with len chars at pRhs */
+        inline bool equals(const char* pRhs, size_t len) const noexcept
+        {
+            const auto decoded = decode();
+            return decoded.m_Size == len && 0 == memcmp(decoded.m_pData, pRhs, len);
+        }
 
-    SString8(std::initializer_list<CharT> ilist); // test - String8TestConstructorInitialiserList
+        // Hashing.  Strings of 7 chars or fewer hash their buffer word (as it is, or as it would be for a heap or non-SString8 string), so a buffer string never reads memory other than itself.
+        // Longer strings are hashed 16 bytes per step.  The same chars always give the same hash, whichever tier holds them.
 
-#if __cplusplus >= 202002L
-    template<class StringViewLike>
-        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
-        && !std::is_convertible_v<const StringViewLike&, const CharT*>
-    explicit SString8(const StringViewLike& t) //  test - String8TestConstructorStringViewLike
-    {
-        std::string_view str(t);
-        SString8 tempstr(str);
-        swap(tempstr);
-    }
+        static inline constexpr uint64_t hash_k0 = 0xa0761d6478bd642fULL;
+        static inline constexpr uint64_t hash_k1 = 0xe7037ed1a0b428dbULL;
+        static inline constexpr uint64_t hash_k2 = 0x8ebc6af09c88c6e3ULL;
 
-    template<class StringViewLike>
-        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
-        && !std::is_convertible_v<const StringViewLike&, const CharT*>
-    explicit SString8(const StringViewLike& t, size_type pos, size_type n) // test - String8TestConstructorStringViewLikePosN
-    {
-        std::string_view str(t);
-        const auto count = SString8::check_count(str, pos, n);
-        SString8 tempstr(str.data() + pos, str.data() + pos + count);
-        swap(tempstr);
-    }
+        /** 64 x 64 -> 128 bit multiply, folded back to 64 bits */
+        static inline uint64_t hashMix(uint64_t lhs, uint64_t rhs) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            const auto product = static_cast<unsigned __int128>(lhs) * rhs;
+            return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64U);
+#elif defined(_MSC_VER)
+            uint64_t high = 0;
+            const auto low = _umul128(lhs, rhs, &high);
+            return low ^ high;
+#else
+#error "no 128 bit multiply available"
 #endif
+        }
 
-    inline void swap(SString8& rhs) // test - SString8TestSwap
-    {
-        m_Storage.swap(rhs.m_Storage);
-    }
-    inline friend void swap(SString8& lhs, SString8& rhs) // test - SString8TestSwap
-    {
-        lhs.swap(rhs);
-    }
-
-    SString8(const SString8& /*rhs*/) = default; // SString8TestConstructorCopy
-    SString8& operator=(const SString8& /*rhs*/) = default; // SString8TestAssignment
-    SString8(SString8&& /*rhs*/) noexcept = default; // SString8TestConstructorMove
-    SString8& operator=(SString8&& /*rhs*/) noexcept = default; // SString8TestAssignmentMove
+        /** One multiply, with xor-shifts either side.  Every step is invertible, so distinct buffer strings never collide in the full 64 bits */
+        static inline uint64_t hashWord(uint64_t word) noexcept
+        {
+            word ^= word >> 32U;
+            word *= hash_k1;
+            return word ^ (word >> 29U);
+        }
 
-    ~SString8() noexcept = default;
+        static inline uint64_t loadWord(const char* p) noexcept
+        {
+            uint64_t word;
+            memcpy(&word, p, sizeof(word));
+            return word;
+        }
 
-    const CharT* data() const noexcept; // test - SString8TestData
-    CharT* data() noexcept; // test - SString8TestData
-    size_type size() const noexcept; // test - SString8TestSizeLength
-    size_type length() const noexcept; // test - SString8TestSizeLength
-    size_type capacity() const noexcept;
+        /** The word that a buffer string holding these len (<= 7) chars would have */
+        static inline uint64_t makeBufferWord(const char* p, size_t len) noexcept
+        {
+            ASSERT(len <= 7);
+            uint64_t word = 0;
+            if (len >= 4)
+            {
+                // two overlapping 4 byte loads, rather than a variable length memcpy.  Overlapping bytes are the same in both, so or-ing is fine
+                uint32_t low;
+                uint32_t high;
+                memcpy(&low, p, sizeof(low));
+                memcpy(&high, p + len - 4, sizeof(high));
+                word = low | (static_cast<uint64_t>(high) << (8U * (len - 4)));
+            }
+            else if (len != 0)
+            {
+                // first, middle and last, which between them cover 1 to 3 chars
+                const auto mid = len / 2;
+                word = static_cast<uint64_t>(static_cast<uint8_t>(p[0]))
+                    | (static_cast<uint64_t>(static_cast<uint8_t>(p[mid])) << (8U * mid))
+                    | (static_cast<uint64_t>(static_cast<uint8_t>(p[len - 1])) << (8U * (len - 1)));
+            }
+            return word | (static_cast<uint64_t>(7U - len) << 56U);
+        }
 
-    friend auto operator<=>(const SString8& lhs, const SString8& rhs) noexcept // test - SString8TestSpaceshipEqEq
-    {
-        const auto thisdata = std::string_view(lhs.data(), lhs.size());
-        const auto thatdata = std::string_view(rhs.data(), rhs.size());
-        const auto cmp = thisdata <=> thatdata;
-        return cmp;
+        static inline uint64_t hashBytes(const char* p, size_t len) noexcept
+        {
+            if (len <= 7)
+                return hashWord(makeBufferWord(p, len));
+            auto h = hashMix(len ^ hash_k0, hash_k2);
+            const auto pEnd = p + len;
+            if (len > 16)
+            {
+                for (; pEnd - p > 16; p += 16)
+                    h = hashMix(loadWord(p) ^ hash_k1, loadWord(p + 8) ^ h);
+                // the last 16 bytes, overlapping what has already been hashed
+                return hashMix(hashMix(loadWord(pEnd - 16) ^ hash_k1, loadWord(pEnd - 8) ^ h), hash_k2);
+            }
+            // 8 to 16 chars - two loads, overlapping if fewer than 16
+            return hashMix(hashMix(loadWord(p) ^ hash_k1, loadWord(pEnd - 8) ^ h), hash_k2);
+        }
+
+        inline uint64_t hash() const noexcept
+        {
+            const auto word = m_Storage.m_pLargeStr;
+            if ((word & top) == 0)
+                return hashWord(word);
+            const auto decoded = decode();
+            return hashBytes(decoded.m_pData, decoded.m_Size);
+        }
+
+        // Searching, with positions and results as for std::string.  A buffer string is searched within its word (see SString8Search.h), reading no other memory.
+        // Heap strings are searched by the kernels in SString8Search.cpp.
+
+        static inline constexpr size_t npos = Search::npos;
+
+        /** The first index from pos at which the len chars at pNeedle start */
+        SSTRING8_INLINE size_t find(const char* pNeedle, size_t len, size_t pos) const noexcept
+        {
+            const auto word = m_Storage.m_pLargeStr;
+            if ((word & top) == 0)
+            {
+                const auto sz = 7U - (word >> 56U);
+                if (pos > sz || len > sz - pos)
+                    return npos;
+                if (len == 0)
+                    return pos;
+                // the needle is at most 7 chars, so it fits in a word, which is compared with the string's word shifted along to each place that its first char is
+                const auto lenMask = (1ULL << (8U * len)) - 1U;
+                const auto needle = makeBufferWord(pNeedle, len) & lenMask;
+                for (auto hits = Search::zeroBytes(word ^ Search::broadcast(pNeedle[0])) & Search::lanes(pos, sz - len + 1U); hits != 0; hits &= hits - 1U)
+                {
+                    const auto i = static_cast<size_t>(std::countr_zero(hits)) / 8U;
+                    if (((word >> (8U * i)) & lenMask) == needle)
+                        return i;
+                }
+                return npos;
+            }
+            const auto [pData, sz] = getHeapDataAndSize();
+            if (pos > sz || len > sz - pos)
+                return npos;
+            if (len == 0)
+                return pos;
+            const auto found = Search::find(pData + pos, sz - pos, pNeedle, len);
+            return (found == npos) ? npos : pos + found;
+        }
+
+        SSTRING8_INLINE size_t find(char ch, size_t pos) const noexcept
+        {
+            const auto word = m_Storage.m_pLargeStr;
+            if ((word & top) == 0)
+            {
+                const auto sz = 7U - (word >> 56U);
+                if (pos >= sz)
+                    return npos;
+                const auto hits = Search::zeroBytes(word ^ Search::broadcast(ch)) & Search::lanes(pos, sz);
+                return (hits == 0) ? npos : std::countr_zero(hits) / 8U;
+            }
+            const auto [pData, sz] = getHeapDataAndSize();
+            if (pos >= sz)
+                return npos;
+            const auto found = Search::findChar(pData + pos, sz - pos, ch);
+            return (found == npos) ? npos : pos + found;
+        }
+
+        /** The last index, no later than pos, at which the len chars at pNeedle start */
+        size_t rfind(const char* pNeedle, size_t len, size_t pos) const noexcept
+        {
+            const auto word = m_Storage.m_pLargeStr;
+            if ((word & top) == 0)
+            {
+                const auto sz = 7U - (word >> 56U);
+                if (len > sz)
+                    return npos;
+                const auto start = (pos < sz - len) ? pos : sz - len;
+                if (len == 0)
+                    return start;
+                const auto lenMask = (1ULL << (8U * len)) - 1U;
+                const auto needle = makeBufferWord(pNeedle, len) & lenMask;
+                for (auto i = start + 1; i-- != 0;)
+                {
+                    if (((word >> (8U * i)) & lenMask) == needle)
+                        return i;
+                }
+                return npos;
+            }
+            const auto [pData, sz] = getDataAndSize();
+            if (len > sz)
+                return npos;
+            const auto start = (pos < sz - len) ? pos : sz - len;
+            if (len == 0)
+                return start;
+            return Search::rfind(pData, start + len, pNeedle, len);
+        }
+
+        size_t rfind(char ch, size_t pos) const noexcept
+        {
+            const auto word = m_Storage.m_pLargeStr;
+            if ((word & top) == 0)
+            {
+                const auto sz = 7U - (word >> 56U);
+                if (sz == 0)
+                    return npos;
+                const auto end = (pos < sz) ? pos + 1 : sz;
+                const auto hits = Search::zeroBytes(word ^ Search::broadcast(ch)) & Search::lanes(0, end);
+                return (hits == 0) ? npos : (63U - std::countl_zero(hits)) / 8U;
+            }
+            const auto [pData, sz] = getDataAndSize();
+            if (sz == 0)
+                return npos;
+            return Search::rfindChar(pData, (pos < sz) ? pos + 1 : sz, ch);
+        }
+
+        /** The first index from pos of a char that is one of the len chars at pSet (or with notOf, that is not one of them) */
+        size_t findOf(const char* pSet, size_t len, size_t pos, bool notOf) const noexcept
+        {
+            const auto word = m_Storage.m_pLargeStr;
+            if ((word & top) == 0 && len <= 7)
+            {
+                const auto sz = 7U - (word >> 56U);
+                if (pos >= sz)
+                    return npos;
+                const auto hits = bufferSetHits(word, pSet, len, notOf) & Search::lanes(pos, sz);
+                return (hits == 0) ? npos : std::countr_zero(hits) / 8U;
+            }
+            const auto [pData, sz] = getDataAndSize();
+            if (pos >= sz)
+                return npos;
+            const auto found = Search::findOf(pData + pos, sz - pos, pSet, len, notOf);
+            return (found == npos) ? npos : pos + found;
+        }
+
+        /** The last index, no later than pos, of a char that is one of the len chars at pSet (or with notOf, that is not one of them) */
+        size_t rfindOf(const char* pSet, size_t len, size_t pos, bool notOf) const noexcept
+        {
+            const auto word = m_Storage.m_pLargeStr;
+            if ((word & top) == 0 && len <= 7)
+            {
+                const auto sz = 7U - (word >> 56U);
+                if (sz == 0)
+                    return npos;
+                const auto end = (pos < sz) ? pos + 1 : sz;
+                const auto hits = bufferSetHits(word, pSet, len, notOf) & Search::lanes(0, end);
+                return (hits == 0) ? npos : (63U - std::countl_zero(hits)) / 8U;
+            }
+            const auto [pData, sz] = getDataAndSize();
+            if (sz == 0)
+                return npos;
+            return Search::rfindOf(pData, (pos < sz) ? pos + 1 : sz, pSet, len, notOf);
+        }
+
+        /** 0x80 in each byte of a buffer word whose char is one of the len chars at pSet (or with notOf, is not) */
+        static uint64_t bufferSetHits(uint64_t word, const char* pSet, size_t len, bool notOf) noexcept
+        {
+            uint64_t hits = 0;
+            for (size_t i = 0; i < len; ++i)
+                hits |= Search::zeroBytes(word ^ Search::broadcast(pSet[i]));
+            return notOf ? ~hits : hits;
+        }
+
+        /**
+        Append len chars, written by write(char* pDest), growing geometrically (see calcGrowthCapacity) if they don't fit, or copying first if the chars are borrowed or shared.
+        When growing, the old storage stays alive until write has been called, so write may read from this string.
+        */
+        template<class Write>
+        void appendWith(size_t len, Write&& write)
+        {
+            const auto decoded = decode();
+            const auto newSize = decoded.m_Size + len;
+            if (fitsInPlace(decoded, newSize))
+            {
+                write(decoded.m_pData + decoded.m_Size);
+                decoded.m_pData[newSize] = '\0';
+                setSize(newSize, decoded.m_Type);
+                return;
+            }
+            basic_SString8Data grown;
+            grown.allocatePtr(decoded.m_pData, decoded.m_Size, calcCopyCapacity(decoded, newSize));
+            const auto grownDecoded = grown.decode();
+            write(grownDecoded.m_pData + decoded.m_Size);
+            grownDecoded.m_pData[newSize] = '\0';
+            grown.setSize(newSize, grownDecoded.m_Type);
+            swap(grown);
+        }
+
+        /**
+        Replace the string with len chars, written by write(char* pDest).
+        They are written in place if they fit (and the string isn't borrowed or shared), otherwise to a new allocation of just enough capacity.
+        When replacing, the old storage stays alive until write has been called, so write may read from this string, but in place it must cope with overlap.
+        */
+        template<class Write>
+        void assignWith(size_t len, Write&& write)
+        {
+            const auto decoded = decode();
+            if (fitsInPlace(decoded, len))
+            {
+                write(decoded.m_pData);
+                decoded.m_pData[len] = '\0';
+                setSize(len, decoded.m_Type);
+                return;
+            }
+            basic_SString8Data replacement;
+            if (len <= 7)
+            {
+                // a buffer word, made from the chars written to an array the compiler can see the size of (rather than via decode(), where a null terminator after them looks like a write past the word)
+                char chars[8];
+                write(chars);
+                replacement.m_Storage.m_pLargeStr = makeBufferWord(chars, len);
+            }
+            else
+            {
+                replacement.allocatePtrWith(len, calcCapacity(len), write);
+            }
+            swap(replacement);
+        }
+
+        /** Replace the string with len chars from pRhs, which may point into this string */
+        void assign(const char* pRhs, size_t len)
+        {
+            if (len <= 7)
+            {
+                // the whole word in one go, eg for each field when splitting records (the chars are read before the word is written, so may be in this string)
+                const auto word = makeBufferWord(pRhs, len);
+                if (isBuffer())
+                {
+                    m_Storage.m_pLargeStr = word;
+                    return;
+                }
+                // and the chars of the same word into a heap string with room for all 8 bytes, rather than a memmove of a few chars.
+                // Without the buffer's size byte, the bytes after the chars (the null terminator and the rest) are all zero
+                const auto decoded = decode();
+                if (decoded.m_Capacity >= 7 && fitsInPlace(decoded, len))
+                {
+                    const auto chars = word & ~(0xFFULL << 56U);
+                    memcpy(decoded.m_pData, &chars, sizeof(chars));
+                    setSize(len, decoded.m_Type);
+                    return;
+                }
+            }
+            assignWith(len, [pRhs, len](char* pDest) { memmove(pDest, pRhs, len); });
+        }
+
+        /** Append len chars from pRhs, which may point into this string */
+        void append(const char* pRhs, size_t len)
+        {
+            appendWith(len, [pRhs, len](char* pDest) { memcpy(pDest, pRhs, len); });
+        }
+
+        void push_back(char ch)
+        {
+            const auto word = m_Storage.m_pLargeStr;
+            const auto sz = 7U - (word >> 56U); // only meaningful for the buffer
+            if ((word & top) == 0 && sz < 7)
+            {
+                // build the new word in a register: keep the existing chars, add ch, the next byte is the null terminator, and byte 7 is (7 - new size)
+                const auto shift = 8U * sz;
+                m_Storage.m_pLargeStr = (word & ((1ULL << shift) - 1U)) | (static_cast<uint64_t>(static_cast<uint8_t>(ch)) << shift) | ((6U - sz) << 56U);
+                return;
+            }
+            append(1, ch);
+        }
+
+        void append(size_t count, char ch)
+        {
+            appendWith(count, [count, ch](char* pDest) { memset(pDest, ch, count); });
+        }
+
+        /**
+        Insert len chars, written by write(char* pDest), at pos (which must be <= size()), growing geometrically if they don't fit.
+        write must not read from this string.
+        */
+        template<class Write>
+        void insertWith(size_t pos, size_t len, Write&& write)
+        {
+            const auto decoded = decode();
+            ASSERT(pos <= decoded.m_Size);
+            const auto newSize = decoded.m_Size + len;
+            if (fitsInPlace(decoded, newSize))
+            {
+                memmove(decoded.m_pData + pos + len, decoded.m_pData + pos, decoded.m_Size - pos);
+                write(decoded.m_pData + pos);
+                decoded.m_pData[newSize] = '\0';
+                setSize(newSize, decoded.m_Type);
+                return;
+            }
+            basic_SString8Data grown;
+            grown.allocatePtr(decoded.m_pData, pos, calcCopyCapacity(decoded, newSize));
+            const auto grownDecoded = grown.decode();
+            write(grownDecoded.m_pData + pos);
+            memcpy(grownDecoded.m_pData + pos + len, decoded.m_pData + pos, decoded.m_Size - pos);
+            grownDecoded.m_pData[newSize] = '\0';
+            grown.setSize(newSize, grownDecoded.m_Type);
+            swap(grown);
+        }
+
+        /** Insert len chars from pRhs at pos.  pRhs may point into this string */
+        void insert(size_t pos, const char* pRhs, size_t len)
+        {
+            const auto [pData, sz] = getDataAndSize();
+            const std::less_equal<const char*> lessEq;
+            if (lessEq(pData, pRhs) && lessEq(pRhs, pData + sz))
+            {
+                // the chars to insert will move as we make room for them, so take a copy first
+                const basic_SString8Data copy(pRhs, len);
+                insert(pos, copy.data(), len);
+                return;
+            }
+            insertWith(pos, len, [pRhs, len](char* pDest) { memcpy(pDest, pRhs, len); });
+        }
+
+        void insert(size_t pos, size_t count, char ch)
+        {
+            insertWith(pos, count, [count, ch](char* pDest) { memset(pDest, ch, count); });
+        }
+
+        /** Allocate enough space for count+1 (including potentially even capacity and the null terminator)
+           then write in count copies of ch, and null terminate */
+        basic_SString8Data(size_t count, char ch);
+    };
+
+    using SString8Data = basic_SString8Data<std::allocator<char>>;
+
+    struct SString8Access;
+} // namespace detail
+
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <ostream>
+#include <istream>
+#include <initializer_list>
+#include <type_traits>
+#include <iterator>
+#include <compare>
+#include <algorithm>
+#include <memory_resource>
+
+#include "SString8Slab.h"
+
+/** Slab blocks come in 16 byte classes, and anything bigger comes from operator new */
+template<class T>
+struct SString8Detail::AllocatorSizeClasses<SString8SlabAllocator<T>>
+{
+    static constexpr size_t usableSize(size_t bytes) noexcept
+    {
+        if (bytes - 1U < Slab::maxBlockSize)
+            return (bytes + Slab::granularity - 1U) & ~(Slab::granularity - 1U);
+        return MallocSizeClasses::usableSize(bytes);
+    }
+};
+
+/**
+Sets the std::pmr::memory_resource that SString8PmrAllocator allocates from on this thread, until it goes out of scope.
+Scopes nest, and without one the allocator uses std::pmr::get_default_resource().
+*/
+class SString8ResourceScope
+{
+public:
+    explicit SString8ResourceScope(std::pmr::memory_resource* pResource) noexcept
+        : m_pPrevious(t_pCurrent)
+    {
+        t_pCurrent = pResource;
+    }
+    ~SString8ResourceScope() noexcept
+    {
+        t_pCurrent = m_pPrevious;
+    }
+    SString8ResourceScope(const SString8ResourceScope&) = delete;
+    SString8ResourceScope& operator=(const SString8ResourceScope&) = delete;
+
+    static std::pmr::memory_resource* current() noexcept
+    {
+        return t_pCurrent ? t_pCurrent : std::pmr::get_default_resource();
+    }
+
+private:
+    std::pmr::memory_resource* m_pPrevious;
+    static inline thread_local std::pmr::memory_resource* t_pCurrent = nullptr;
+};
+
+/**
+Stateless allocator taking its memory from SString8ResourceScope::current(), so that a string using it is still only 8 bytes.
+Each allocation keeps a pointer to its resource in the 8 bytes in front of it, so it is freed to the resource it came from, whatever is current at the time.
+With a std::pmr::monotonic_buffer_resource, allocation is a pointer bump and everything is freed at once when the resource is released.
+*/
+template<class T>
+struct SString8PmrAllocator
+{
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    SString8PmrAllocator() noexcept = default;
+    template<class U>
+    SString8PmrAllocator(const SString8PmrAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        auto pResource = SString8ResourceScope::current();
+        auto p = static_cast<char*>(pResource->allocate(prefix + n * sizeof(T), alignment));
+        memcpy(p, &pResource, sizeof(pResource));
+        return reinterpret_cast<T*>(p + prefix);
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        auto pAlloc = reinterpret_cast<char*>(p) - prefix;
+        std::pmr::memory_resource* pResource = nullptr;
+        memcpy(&pResource, pAlloc, sizeof(pResource));
+        pResource->deallocate(pAlloc, prefix + n * sizeof(T), alignment);
+    }
+
+    friend bool operator==(const SString8PmrAllocator&, const SString8PmrAllocator&) noexcept { return true; }
+
+private:
+    // at least 8 byte alignment, as SString8 keeps its storage tier in the bottom bits of the pointer and reads 8 byte headers
+    static constexpr size_t alignment = (alignof(T) > alignof(std::pmr::memory_resource*)) ? alignof(T) : alignof(std::pmr::memory_resource*);
+    static constexpr size_t prefix = (sizeof(std::pmr::memory_resource*) > alignment) ? sizeof(std::pmr::memory_resource*) : alignment;
+};
+
+/**
+An alternative to std::string which is only 8 bytes in size as opposed to the usual 24-32 bytes.
+Only valid on a 64 bit  system.
+Otimised for very short strings - has a 7 byte buffer (as opposed to the more usual 15 or 23)
+It does support the full range of string sizes, but once the string is bigger than 254 bytes it will be less performant than a std::string (though still smaller)
+No documentation as it is the same as std::string
+Heap allocations are made through Alloc, which must be a stateless allocator of char (so that the string stays at 8 bytes).  Use the SString8 and PmrSString8 aliases.
+*/
+template<class Alloc>
+class basic_SString8
+{
+public:
+    using size_type = size_t;
+    using CharT = char;
+
+    // constructors
+
+    basic_SString8(std::nullptr_t) = delete;
+
+    basic_SString8() noexcept = default; // test - String8TestDefaultConstructor
+
+    // construction from chars, size() and comparison are constexpr for strings of 7 chars or fewer (see also the _s8 literal)
+
+    constexpr basic_SString8(std::string_view str) // test - String8TestConstructorStringView
+        : m_Storage(str)
+    {
     }
-    friend bool operator==(const SString8& lhs, const SString8& rhs) noexcept // test - SString8TestSpaceshipEqEq
+    basic_SString8(const std::string& str); // test - String8TestConstructorString
+    operator std::string_view() const; // test - String8Testoperatotstdstringview
+
+    basic_SString8(size_type count, CharT ch); // test - String8TestConstructorCountChar
+
+    basic_SString8(const basic_SString8& other, size_type pos); // test - String8TestConstructorOtherPos
+    basic_SString8(const std::string& other, size_type pos); // test - String8TestConstructorOtherPos
+
+    basic_SString8(const basic_SString8& other, size_type pos, size_type count); // test - String8TestConstructorOtherPosCount
+    basic_SString8(const std::string& other, size_type pos, size_type count); // test - String8TestConstructorOtherPosCount
+
+    constexpr basic_SString8(const CharT* s, size_type count) // test - String8TestConstructorCharStarCount
+        : m_Storage(s, count)
     {
-        const auto thislen = lhs.size();
+    }
 
-        if (thislen != rhs.size())
-            return false;
+    constexpr basic_SString8(const CharT* s) // test - String8TestConstructorCharStar
+        : m_Storage(s, std::char_traits<CharT>::length(s))
+    {
+    }
 
-        return 0 == strncmp(lhs.data(), rhs.data(), thislen);
+    /**
+    A string referring to the chars of str without copying them, eg for keys in a memory mapped file.
+    str must be followed by a null terminator, and its chars must stay valid and unchanged for as long as the result (or any copy of it) exists.
+    Copies are O(1), nothing is freed, and any change first copies the chars into a heap allocation of the string's own.
+    Strings of 7 chars or fewer go in the buffer, and strings of more than 8191 chars are copied.
+    */
+    static basic_SString8 borrow(std::string_view str); // test - SString8TestBorrow
+    bool isBorrowed() const noexcept; // test - SString8TestBorrow
+
+    /** Forward iterators allocate the right tier once and copy straight in.  Input iterators fill the buffer and then grow geometrically */
+    template<class InputIt>
+        requires std::input_iterator<InputIt>
+    basic_SString8(InputIt first, InputIt last) // test - String8TestConstructorInputItFirstLast
+    {
+        assign(first, last);
     }
 
-    friend std::ostream& operator<<(std::ostream& os, const SString8& str)
+    basic_SString8(std::initializer_list<CharT> ilist); // test - String8TestConstructorInitialiserList
+
+#if __cplusplus >= 202002L
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    explicit basic_SString8(const StringViewLike& t) //  test - String8TestConstructorStringViewLike
+        : m_Storage(std::string_view(t))
     {
-        return os << str.data();
+    }
+
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    explicit basic_SString8(const StringViewLike& t, size_type pos, size_type n) // test - String8TestConstructorStringViewLikePosN
+    {
+        const std::string_view str(t);
+        const auto count = basic_SString8::check_count(str, pos, n);
+        m_Storage.assign(str.data() + pos, count);
+    }
+#endif
+
+    inline void swap(basic_SString8& rhs) // test - SString8TestSwap
+    {
+        m_Storage.swap(rhs.m_Storage);
+    }
+    inline friend void swap(basic_SString8& lhs, basic_SString8& rhs) // test - SString8TestSwap
+    {
+        lhs.swap(rhs);
+    }
+
+    constexpr basic_SString8(const basic_SString8& /*rhs*/) = default; // SString8TestConstructorCopy
+    basic_SString8& operator=(const basic_SString8& /*rhs*/) = default; // SString8TestAssignment
+    constexpr basic_SString8(basic_SString8&& /*rhs*/) noexcept = default; // SString8TestConstructorMove
+    basic_SString8& operator=(basic_SString8&& /*rhs*/) noexcept = default; // SString8TestAssignmentMove
+
+    constexpr ~basic_SString8() noexcept = default;
+
+    const CharT* data() const noexcept; // test - SString8TestData
+    CharT* data(); // test - SString8TestData - a borrowed or shared string is copied first
+    constexpr size_type size() const noexcept // test - SString8TestSizeLength
+    {
+        return m_Storage.size();
+    }
+    constexpr size_type length() const noexcept // test - SString8TestSizeLength
+    {
+        return size();
+    }
+    size_type capacity() const noexcept;
+
+    friend constexpr std::strong_ordering operator<=>(const basic_SString8& lhs, const basic_SString8& rhs) noexcept // test - SString8TestSpaceshipEqEq
+    {
+        return Data::compare(lhs.m_Storage, rhs.m_Storage) <=> 0;
+    }
+    friend constexpr bool operator==(const basic_SString8& lhs, const basic_SString8& rhs) noexcept // test - SString8TestSpaceshipEqEq
+    {
+        return Data::equals(lhs.m_Storage, rhs.m_Storage);
+    }
+
+    constexpr int compare(const basic_SString8& str) const noexcept // test - SString8TestCompare
+    {
+        return Data::compare(m_Storage, str.m_Storage);
+    }
+    int compare(const CharT* s) const noexcept; // test - SString8TestCompare
+#if __cplusplus >= 202002L
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    int compare(const StringViewLike& t) const noexcept // test - SString8TestCompare
+    {
+        const std::string_view str(t);
+        return m_Storage.compare(str.data(), str.size());
+    }
+#endif
+
+    // searching - as std::string, giving npos when there is nothing found.  Strings of 7 chars or fewer are searched within their 8 bytes,
+    // and longer ones with memchr for chars and short needles, and otherwise with kernels for the best instruction set that the CPU has
+    // (see SString8Search.h).  find is forced inline, with the needle's length known at the call, so that a search of a short string
+    // costs no more than one of a string_view
+
+    size_type find(const basic_SString8& str, size_type pos = 0) const noexcept // test - SString8TestFind
+    {
+        const auto [pStr, len] = str.m_Storage.getDataAndSize();
+        return m_Storage.find(pStr, len, pos);
+    }
+    SSTRING8_INLINE size_type find(const CharT* s, size_type pos, size_type count) const { return m_Storage.find(s, count, pos); } // test - SString8TestFind
+    SSTRING8_INLINE size_type find(const CharT* s, size_type pos = 0) const { return m_Storage.find(s, strlen(s), pos); } // test - SString8TestFind
+    SSTRING8_INLINE size_type find(CharT ch, size_type pos = 0) const noexcept { return m_Storage.find(ch, pos); } // test - SString8TestFind
+#if __cplusplus >= 202002L
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    size_type find(const StringViewLike& t, size_type pos = 0) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>) // test - SString8TestFind
+    {
+        const std::string_view str(t);
+        return find(str.data(), pos, str.size());
+    }
+#endif
+
+    size_type rfind(const basic_SString8& str, size_type pos = npos) const noexcept; // test - SString8TestRfind
+    size_type rfind(const CharT* s, size_type pos, size_type count) const; // test - SString8TestRfind
+    size_type rfind(const CharT* s, size_type pos = npos) const; // test - SString8TestRfind
+    size_type rfind(CharT ch, size_type pos = npos) const noexcept; // test - SString8TestRfind
+#if __cplusplus >= 202002L
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    size_type rfind(const StringViewLike& t, size_type pos = npos) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>) // test - SString8TestRfind
+    {
+        const std::string_view str(t);
+        return rfind(str.data(), pos, str.size());
+    }
+#endif
+
+    size_type find_first_of(const basic_SString8& str, size_type pos = 0) const noexcept; // test - SString8TestFindFirstOf
+    size_type find_first_of(const CharT* s, size_type pos, size_type count) const; // test - SString8TestFindFirstOf
+    size_type find_first_of(const CharT* s, size_type pos = 0) const; // test - SString8TestFindFirstOf
+    size_type find_first_of(CharT ch, size_type pos = 0) const noexcept; // test - SString8TestFindFirstOf
+#if __cplusplus >= 202002L
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    size_type find_first_of(const StringViewLike& t, size_type pos = 0) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>) // test - SString8TestFindFirstOf
+    {
+        const std::string_view str(t);
+        return find_first_of(str.data(), pos, str.size());
+    }
+#endif
+
+    size_type find_first_not_of(const basic_SString8& str, size_type pos = 0) const noexcept; // test - SString8TestFindFirstNotOf
+    size_type find_first_not_of(const CharT* s, size_type pos, size_type count) const; // test - SString8TestFindFirstNotOf
+    size_type find_first_not_of(const CharT* s, size_type pos = 0) const; // test - SString8TestFindFirstNotOf
+    size_type find_first_not_of(CharT ch, size_type pos = 0) const noexcept; // test - SString8TestFindFirstNotOf
+#if __cplusplus >= 202002L
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    size_type find_first_not_of(const StringViewLike& t, size_type pos = 0) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>) // test - SString8TestFindFirstNotOf
+    {
+        const std::string_view str(t);
+        return find_first_not_of(str.data(), pos, str.size());
+    }
+#endif
+
+    size_type find_last_of(const basic_SString8& str, size_type pos = npos) const noexcept; // test - SString8TestFindLastOf
+    size_type find_last_of(const CharT* s, size_type pos, size_type count) const; // test - SString8TestFindLastOf
+    size_type find_last_of(const CharT* s, size_type pos = npos) const; // test - SString8TestFindLastOf
+    size_type find_last_of(CharT ch, size_type pos = npos) const noexcept; // test - SString8TestFindLastOf
+#if __cplusplus >= 202002L
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    size_type find_last_of(const StringViewLike& t, size_type pos = npos) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>) // test - SString8TestFindLastOf
+    {
+        const std::string_view str(t);
+        return find_last_of(str.data(), pos, str.size());
+    }
+#endif
+
+    size_type find_last_not_of(const basic_SString8& str, size_type pos = npos) const noexcept; // test - SString8TestFindLastNotOf
+    size_type find_last_not_of(const CharT* s, size_type pos, size_type count) const; // test - SString8TestFindLastNotOf
+    size_type find_last_not_of(const CharT* s, size_type pos = npos) const; // test - SString8TestFindLastNotOf
+    size_type find_last_not_of(CharT ch, size_type pos = npos) const noexcept; // test - SString8TestFindLastNotOf
+#if __cplusplus >= 202002L
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    size_type find_last_not_of(const StringViewLike& t, size_type pos = npos) const noexcept(std::is_nothrow_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>) // test - SString8TestFindLastNotOf
+    {
+        const std::string_view str(t);
+        return find_last_not_of(str.data(), pos, str.size());
+    }
+#endif
+
+    bool contains(std::string_view str) const noexcept; // test - SString8TestContains
+    bool contains(CharT ch) const noexcept; // test - SString8TestContains
+    bool contains(const CharT* s) const; // test - SString8TestContains
+
+    friend struct SString8Hash;
+    friend struct SString8Equal;
+    friend struct SString8Detail::SString8Access;
+
+    /** All size() chars (including any null chars) in one write, padded to os.width() as std::string.  For writing many strings to a file, see SString8Writer */
+    friend std::ostream& operator<<(std::ostream& os, const basic_SString8& str) // test - SString8TestOperatorLtLt
+    {
+        return os << std::string_view(str.data(), str.size());
+    }
+
+    // reading - as std::string, into the string's existing storage, so reading line after line into the same string settles down to no allocation.
+    // For reading lines from a file or from memory without an istream, see SString8LineReader
+
+    /** As std::operator>>: skips whitespace, then reads a word of up to is.width() chars (if not 0) */
+    friend std::istream& operator>>(std::istream& is, basic_SString8& str) // test - SString8TestOperatorGtGt
+    {
+        return str.readWord(is);
+    }
+    /** As std::getline: reads up to delim, which is extracted but not stored */
+    friend std::istream& getline(std::istream& is, basic_SString8& str, CharT delim) // test - SString8TestGetline
+    {
+        return str.readLine(is, delim);
+    }
+    friend std::istream& getline(std::istream& is, basic_SString8& str) // test - SString8TestGetline
+    {
+        return str.readLine(is, is.widen('\n'));
     }
 
     void reserve(size_type new_cap = 0); //SString8Testreserve
+    /** Moves to the smallest tier that holds the string, which for 7 chars or fewer is the buffer, with no heap allocation */
+    void shrink_to_fit(); // test - SString8TestShrinkToFit
+    /** As std::string::clear, keeping the capacity, unless releaseMemory is true, which also frees any heap allocation */
+    void clear(bool releaseMemory = false) noexcept; // test - SString8TestClear
+
+    static constexpr size_type npos = std::string::npos;
+
+    // appending - capacity grows geometrically, moving up through the storage tiers as needed
+
+    void push_back(CharT ch); // test - SString8TestPushBack
+
+    basic_SString8& append(size_type count, CharT ch); // test - SString8TestAppend
+    basic_SString8& append(const basic_SString8& str); // test - SString8TestAppend
+    basic_SString8& append(const basic_SString8& str, size_type pos, size_type count = npos); // test - SString8TestAppend
+    basic_SString8& append(const CharT* s, size_type count); // test - SString8TestAppend
+    basic_SString8& append(const CharT* s); // test - SString8TestAppend
+    basic_SString8& append(std::initializer_list<CharT> ilist); // test - SString8TestAppend
+
+    template<class InputIt>
+        requires std::input_iterator<InputIt>
+    basic_SString8& append(InputIt first, InputIt last) // test - SString8TestAppendInputIt
+    {
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+        {
+            // the size is known up front, so grow at most once
+            const auto count = static_cast<size_type>(std::distance(first, last));
+            m_Storage.appendWith(count, [first, last](CharT* pDest) { std::copy(first, last, pDest); });
+        }
+        else
+        {
+            for (; first != last; ++first)
+                push_back(*first);
+        }
+        return *this;
+    }
 
-    SString8& operator=(const CharT* s);
-    SString8& operator=(CharT ch);
-    SString8& operator=(std::initializer_list<CharT> ilist);
 #if __cplusplus >= 202002L
     template<class StringViewLike>
-    SString8& operator=(const StringViewLike& t)
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    basic_SString8& append(const StringViewLike& t) // test - SString8TestAppend
     {
-        std::string_view str(t);
-        SString8 tempstr(str);
-        return this->operator=(std::move(tempstr));
+        const std::string_view str(t);
+        m_Storage.append(str.data(), str.size());
+        return *this;
+    }
+
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    basic_SString8& append(const StringViewLike& t, size_type pos, size_type count = npos) // test - SString8TestAppend
+    {
+        const std::string_view str(t);
+        const auto n = basic_SString8::check_count(str, pos, count);
+        m_Storage.append(str.data() + pos, n);
+        return *this;
+    }
+#endif
+
+    basic_SString8& operator+=(const basic_SString8& str); // test - SString8TestOperatorPlusEq
+    basic_SString8& operator+=(CharT ch); // test - SString8TestOperatorPlusEq
+    basic_SString8& operator+=(const CharT* s); // test - SString8TestOperatorPlusEq
+    basic_SString8& operator+=(std::initializer_list<CharT> ilist); // test - SString8TestOperatorPlusEq
+#if __cplusplus >= 202002L
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    basic_SString8& operator+=(const StringViewLike& t) // test - SString8TestOperatorPlusEq
+    {
+        return append(t);
+    }
+#endif
+
+    // inserting - throws std::out_of_range if index > size()
+
+    basic_SString8& insert(size_type index, size_type count, CharT ch); // test - SString8TestInsert
+    basic_SString8& insert(size_type index, const CharT* s); // test - SString8TestInsert
+    basic_SString8& insert(size_type index, const CharT* s, size_type count); // test - SString8TestInsert
+    basic_SString8& insert(size_type index, const basic_SString8& str); // test - SString8TestInsert
+    basic_SString8& insert(size_type index, const basic_SString8& str, size_type index_str, size_type count = npos); // test - SString8TestInsert
+#if __cplusplus >= 202002L
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    basic_SString8& insert(size_type index, const StringViewLike& t) // test - SString8TestInsert
+    {
+        const std::string_view str(t);
+        return insert(index, str.data(), str.size());
+    }
+
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    basic_SString8& insert(size_type index, const StringViewLike& t, size_type index_str, size_type count = npos) // test - SString8TestInsert
+    {
+        const std::string_view str(t);
+        const auto n = basic_SString8::check_count(str, index_str, count);
+        return insert(index, str.data() + index_str, n);
+    }
+#endif
+
+    // assigning - the chars are copied into the existing storage if they fit, so assigning to a reused string doesn't allocate
+
+    basic_SString8& operator=(const CharT* s);
+    basic_SString8& operator=(CharT ch);
+    basic_SString8& operator=(std::initializer_list<CharT> ilist);
+    basic_SString8& operator=(const std::string& str); // test - SString8TestAssignReuse
+#if __cplusplus >= 202002L
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    basic_SString8& operator=(const StringViewLike& t) // test - SString8TestAssignReuse
+    {
+        const std::string_view str(t);
+        m_Storage.assign(str.data(), str.size());
+        return *this;
+    }
+#endif
+    basic_SString8& operator=(std::nullptr_t) = delete;
+
+    basic_SString8& assign(size_type count, CharT ch); // test - SString8TestAssign
+    basic_SString8& assign(const basic_SString8& str); // test - SString8TestAssign
+    basic_SString8& assign(const basic_SString8& str, size_type pos, size_type count = npos); // test - SString8TestAssign
+    basic_SString8& assign(const CharT* s, size_type count); // test - SString8TestAssign, SString8TestAssignShort
+    basic_SString8& assign(const CharT* s); // test - SString8TestAssign
+    basic_SString8& assign(std::initializer_list<CharT> ilist); // test - SString8TestAssign
+
+    template<class InputIt>
+        requires std::input_iterator<InputIt>
+    basic_SString8& assign(InputIt first, InputIt last) // test - SString8TestAssign
+    {
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+        {
+            const auto count = static_cast<size_type>(std::distance(first, last));
+            m_Storage.assignWith(count, [first, last](CharT* pDest) { std::copy(first, last, pDest); });
+        }
+        else
+        {
+            m_Storage.assignWith(0, [](CharT*) {});
+            for (; first != last; ++first)
+                push_back(*first);
+        }
+        return *this;
+    }
+
+#if __cplusplus >= 202002L
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    basic_SString8& assign(const StringViewLike& t) // test - SString8TestAssign
+    {
+        const std::string_view str(t);
+        m_Storage.assign(str.data(), str.size());
+        return *this;
+    }
+
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::basic_string_view<CharT>>
+        && (!std::is_convertible_v<const StringViewLike&, const CharT*>)
+    basic_SString8& assign(const StringViewLike& t, size_type pos, size_type count = npos) // test - SString8TestAssign
+    {
+        const std::string_view str(t);
+        const auto n = basic_SString8::check_count(str, pos, count);
+        m_Storage.assign(str.data() + pos, n);
+        return *this;
     }
 #endif
-    SString8& operator=(std::nullptr_t) = delete;
 
 private:
-    SString8Detail::SString8Data m_Storage;
+    using Data = SString8Detail::basic_SString8Data<Alloc>;
+    Data m_Storage;
+
+    std::istream& readWord(std::istream& is);
+    std::istream& readLine(std::istream& is, CharT delim);
+    void storeSpan(const CharT* s, size_type count, bool first);
 
     template<typename StringType>
     inline static size_t check_out_of_range(const StringType& other, size_type pos)
@@ -596,3 +1849,128 @@ private:
 
 
 };
+
+/** SString8 with its small tier allocated from SString8SlabAllocator size classes */
+using SlabSString8 = basic_SString8<SString8SlabAllocator<char>>;
+
+// define SSTRING8_SLAB_ALLOCATOR (for the whole build, including the library) to make SString8 use the slab allocator
+#if defined(SSTRING8_SLAB_ALLOCATOR)
+using SString8 = SlabSString8;
+#else
+using SString8 = basic_SString8<std::allocator<char>>;
+#endif
+
+/** SString8 allocating from the memory resource of the current SString8ResourceScope */
+using PmrSString8 = basic_SString8<SString8PmrAllocator<char>>;
+
+namespace SString8Detail
+{
+    /** The chars of a string literal (including its null terminator), as a template argument of the _s8 literal operator */
+    template<size_t N>
+    struct BufferLiteral
+    {
+        char m_Chars[N] = {};
+        consteval BufferLiteral(const char(&str)[N])
+        {
+            for (size_t i = 0; i < N; ++i)
+                m_Chars[i] = str[i];
+        }
+        static constexpr size_t size = N - 1;
+    };
+} // namespace detail
+
+inline namespace SString8Literals
+{
+    /**
+    "abc"_s8 is a constant initialised SString8, eg for static keyword tables that cost nothing at startup.
+    Only literals of 7 chars or fewer (which fit in the buffer) are allowed - anything longer is a compile error.
+    */
+    template<SString8Detail::BufferLiteral Literal>
+    consteval SString8 operator""_s8() // test - SString8TestConstexpr
+    {
+        static_assert(Literal.size <= 7, "_s8 literals must be 7 chars or fewer, so that they fit in the buffer");
+        return SString8(Literal.m_Chars, Literal.size);
+    }
+}
+
+namespace SString8Detail
+{
+    template<class T>
+    inline constexpr bool isSString8 = false;
+    template<class Alloc>
+    inline constexpr bool isSString8<basic_SString8<Alloc>> = true;
+} // namespace detail
+
+/**
+Transparent hash for SString8, so that unordered containers keyed by SString8 can be searched with a std::string_view, std::string or const char* without building an SString8.
+Gives the same value for the same chars whatever the type.  Use with SString8Equal.
+*/
+struct SString8Hash
+{
+    using is_transparent = void;
+
+    template<class Alloc>
+    size_t operator()(const basic_SString8<Alloc>& str) const noexcept // test - SString8TestHash
+    {
+        return static_cast<size_t>(str.m_Storage.hash());
+    }
+
+    template<class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::string_view>
+        && (!SString8Detail::isSString8<StringViewLike>)
+    size_t operator()(const StringViewLike& t) const noexcept // test - SString8TestHash
+    {
+        const std::string_view str(t);
+        return static_cast<size_t>(SString8Detail::SString8Data::hashBytes(str.data(), str.size()));
+    }
+};
+
+/** Transparent equality for every basic_SString8, to go with SString8Hash */
+struct SString8Equal
+{
+    using is_transparent = void;
+
+    template<class Alloc>
+    bool operator()(const basic_SString8<Alloc>& lhs, const basic_SString8<Alloc>& rhs) const noexcept // test - SString8TestHash
+    {
+        return lhs == rhs;
+    }
+
+    template<class Alloc, class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::string_view>
+        && (!SString8Detail::isSString8<StringViewLike>)
+    bool operator()(const basic_SString8<Alloc>& lhs, const StringViewLike& rhs) const noexcept // test - SString8TestHash
+    {
+        const std::string_view str(rhs);
+        return lhs.m_Storage.equals(str.data(), str.size());
+    }
+
+    template<class Alloc, class StringViewLike>
+        requires std::is_convertible_v<const StringViewLike&, std::string_view>
+        && (!SString8Detail::isSString8<StringViewLike>)
+    bool operator()(const StringViewLike& lhs, const basic_SString8<Alloc>& rhs) const noexcept // test - SString8TestHash
+    {
+        return (*this)(rhs, lhs);
+    }
+};
+
+template<class Alloc>
+struct std::hash<basic_SString8<Alloc>>
+{
+    size_t operator()(const basic_SString8<Alloc>& str) const noexcept // test - SString8TestHash
+    {
+        return SString8Hash()(str);
+    }
+};
+
+namespace SString8Detail
+{
+    /** Gives the containers and algorithms built on SString8 (eg SString8FlatMap) access to its storage word */
+    struct SString8Access
+    {
+        template<class Alloc>
+        static constexpr const basic_SString8Data<Alloc>& storage(const basic_SString8<Alloc>& str) noexcept { return str.m_Storage; }
+        template<class Alloc>
+        static constexpr basic_SString8Data<Alloc>& storage(basic_SString8<Alloc>& str) noexcept { return str.m_Storage; }
+    };
+} // namespace detail
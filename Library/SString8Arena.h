@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace SString8Detail
+{
+    /**
+    Bump allocator for the chars of borrowed SString8s (used by SString8InternPool and SString8Column).
+    Chars are stored with a null terminator, as a borrowed string must have, in 64KB chunks that never move, so what store returns stays valid until reset.
+    A string bigger than a quarter of a chunk gets a block of its own, so the rest of the current chunk isn't wasted.
+    */
+    class CharArena
+    {
+    public:
+        static inline constexpr size_t chunkSize = 64 * 1024;
+
+        CharArena() = default;
+        CharArena(const CharArena&) = delete;
+        CharArena& operator=(const CharArena&) = delete;
+
+        /** The chunks go with the move, and don't move themselves, so what was stored stays valid.  The moved from arena is left empty, ready to store again in chunks of its own */
+        CharArena(CharArena&& rhs) noexcept
+            : m_Chunks(std::move(rhs.m_Chunks))
+            , m_Blocks(std::move(rhs.m_Blocks))
+            , m_BlockBytes(std::exchange(rhs.m_BlockBytes, 0))
+            , m_NextChunk(std::exchange(rhs.m_NextChunk, 0))
+            , m_pFree(std::exchange(rhs.m_pFree, nullptr))
+            , m_FreeBytes(std::exchange(rhs.m_FreeBytes, 0))
+            , m_UsedBytes(std::exchange(rhs.m_UsedBytes, 0))
+        {
+            rhs.m_Chunks.clear();
+            rhs.m_Blocks.clear();
+        }
+
+        CharArena& operator=(CharArena&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                m_Chunks = std::move(rhs.m_Chunks);
+                m_Blocks = std::move(rhs.m_Blocks);
+                rhs.m_Chunks.clear();
+                rhs.m_Blocks.clear();
+                m_BlockBytes = std::exchange(rhs.m_BlockBytes, 0);
+                m_NextChunk = std::exchange(rhs.m_NextChunk, 0);
+                m_pFree = std::exchange(rhs.m_pFree, nullptr);
+                m_FreeBytes = std::exchange(rhs.m_FreeBytes, 0);
+                m_UsedBytes = std::exchange(rhs.m_UsedBytes, 0);
+            }
+            return *this;
+        }
+
+        /** A null terminated copy of str */
+        const char* store(std::string_view str)
+        {
+            const auto bytes = str.size() + 1;
+            char* p = nullptr;
+            if (bytes > chunkSize / 4)
+            {
+                m_Blocks.push_back(std::make_unique_for_overwrite<char[]>(bytes));
+                m_BlockBytes += bytes;
+                p = m_Blocks.back().get();
+            }
+            else
+            {
+                if (bytes > m_FreeBytes)
+                    nextChunk();
+                p = m_pFree;
+                m_pFree += bytes;
+                m_FreeBytes -= bytes;
+            }
+            memcpy(p, str.data(), str.size());
+            p[str.size()] = '\0';
+            m_UsedBytes += bytes;
+            return p;
+        }
+
+        /** Forget every stored string.  The chunks are kept for reuse unless releaseMemory is true */
+        void reset(bool releaseMemory = false) noexcept
+        {
+            m_Blocks.clear();
+            m_BlockBytes = 0;
+            if (releaseMemory)
+                m_Chunks.clear();
+            m_NextChunk = 0;
+            m_pFree = nullptr;
+            m_FreeBytes = 0;
+            m_UsedBytes = 0;
+        }
+
+        /** Bytes holding stored chars and their null terminators */
+        size_t usedBytes() const noexcept { return m_UsedBytes; }
+        /** Bytes allocated, used or not */
+        size_t allocatedBytes() const noexcept { return m_Chunks.size() * chunkSize + m_BlockBytes; }
+
+    private:
+        void nextChunk()
+        {
+            if (m_NextChunk == m_Chunks.size())
+                m_Chunks.push_back(std::make_unique_for_overwrite<char[]>(chunkSize));
+            m_pFree = m_Chunks[m_NextChunk++].get();
+            m_FreeBytes = chunkSize;
+        }
+
+        std::vector<std::unique_ptr<char[]>> m_Chunks;
+        std::vector<std::unique_ptr<char[]>> m_Blocks;
+        size_t m_BlockBytes = 0;
+        size_t m_NextChunk = 0;
+        char* m_pFree = nullptr;
+        size_t m_FreeBytes = 0;
+        size_t m_UsedBytes = 0;
+    };
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "SString8.h"
+#include "SString8Arena.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+A column of strings, eg one field of a batch of records, made to be filled, scanned and thrown away together.
+
+Each entry is an 8 byte SString8.  Strings of 7 chars or fewer are held in the entry itself.
+Strings of 8 to 8191 chars are copied back to back into the column's arena, and the entry is a borrowed SString8 referring to them, so there is no allocation per string,
+a scan reads the chars in the order they were added, and clearing the column frees (or keeps for reuse) a handful of arena chunks rather than one allocation per string.
+Longer strings are held in SString8s of their own.
+
+Entries are read only, and refer to the column's arena: copies of them must not outlive the column, or its next clear.
+*/
+class SString8Column
+{
+public:
+    using value_type = SString8;
+    using size_type = size_t;
+    using const_iterator = std::vector<SString8>::const_iterator;
+
+    SString8Column() = default;
+    SString8Column(const SString8Column&) = delete;
+    SString8Column& operator=(const SString8Column&) = delete;
+    // the arena's chunks don't move, so the entries stay valid, and the moved from column is left empty, with an arena of its own to fill again
+    SString8Column(SString8Column&&) noexcept = default;
+    SString8Column& operator=(SString8Column&&) noexcept = default;
+
+    void push_back(std::string_view str) // test - SString8ColumnTestAppend
+    {
+        if (str.size() <= 7 || str.size() > SString8Detail::SString8Data::max_size_borrowed)
+            m_Entries.emplace_back(str);
+        else
+            m_Entries.push_back(SString8::borrow(std::string_view(m_Arena.store(str), str.size())));
+    }
+
+    std::string_view operator[](size_type pos) const noexcept { return m_Entries[pos]; } // test - SString8ColumnTestAppend
+    /** The entry itself, for passing on as an SString8 (see the class comment for how long it stays valid) */
+    const SString8& entry(size_type pos) const noexcept { return m_Entries[pos]; } // test - SString8ColumnTestAppend
+
+    const_iterator begin() const noexcept { return m_Entries.begin(); } // test - SString8ColumnTestAppend
+    const_iterator end() const noexcept { return m_Entries.end(); } // test - SString8ColumnTestAppend
+
+    size_type size() const noexcept { return m_Entries.size(); } // test - SString8ColumnTestAppend
+    bool empty() const noexcept { return m_Entries.empty(); } // test - SString8ColumnTestAppend
+    /** Room for count entries.  The arena grows a chunk at a time as strings are added */
+    void reserve(size_type count) { m_Entries.reserve(count); } // test - SString8ColumnTestClear
+
+    /** Remove every string.  The entries' capacity and the arena's chunks are kept for the next batch, unless releaseMemory is true */
+    void clear(bool releaseMemory = false) noexcept // test - SString8ColumnTestClear
+    {
+        if (releaseMemory)
+            std::vector<SString8>().swap(m_Entries);
+        else
+            m_Entries.clear();
+        m_Arena.reset(releaseMemory);
+    }
+
+    /** Bytes of arena holding chars, including null terminators */
+    size_t arenaBytes() const noexcept { return m_Arena.usedBytes(); } // test - SString8ColumnTestAppend
+    /** Bytes of arena allocated, used or not */
+    size_t arenaCapacity() const noexcept { return m_Arena.allocatedBytes(); } // test - SString8ColumnTestClear
+
+private:
+    // declared first so that it is destroyed after the entries that refer to it
+    SString8Detail::CharArena m_Arena;
+    std::vector<SString8> m_Entries;
+};
@@ -0,0 +1,240 @@
+#include "SString8Delimited.h"
+#include "SString8Split.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    // below this much of the file per thread, starting another thread costs more than it saves
+    constexpr size_t minChunkBytes = 1024 * 1024;
+    constexpr size_t batchSize = 256;
+
+    /** Call fn(thread) for each of threadCount threads, all but the first on threads of their own.  Rethrows the first exception that any of them threw */
+    template<class Fn>
+    void onThreads(size_t threadCount, Fn&& fn)
+    {
+        std::vector<std::exception_ptr> errors(threadCount);
+        const auto run = [&fn, &errors](size_t thread) noexcept
+            {
+                try
+                {
+                    fn(thread);
+                }
+                catch (...)
+                {
+                    errors[thread] = std::current_exception();
+                }
+            };
+        std::vector<std::thread> threads;
+        for (size_t thread = 1; thread < threadCount; ++thread)
+        {
+            try
+            {
+                threads.emplace_back(run, thread);
+            }
+            catch (...)
+            {
+                // no thread (or no memory for one): this thread does its work instead
+                run(thread);
+            }
+        }
+        run(0);
+        for (auto& thread : threads)
+            thread.join();
+        for (const auto& error : errors)
+        {
+            if (error)
+                std::rethrow_exception(error);
+        }
+    }
+
+    /** Call line(start, end) for each line in [begin, end) of p, where end is the index of the \n (or the end of the last line, which needs none) */
+    template<class Line>
+    void forEachLine(const char* p, size_t begin, size_t end, Line&& line)
+    {
+        size_t positions[batchSize];
+        auto start = begin;
+        for (auto scanFrom = begin;;)
+        {
+            const auto found = SString8Detail::Search::findAllChar(p + scanFrom, end - scanFrom, '\n', positions, batchSize);
+            for (size_t i = 0; i < found; ++i)
+            {
+                const auto lineEnd = scanFrom + positions[i];
+                line(start, lineEnd);
+                start = lineEnd + 1U;
+            }
+            if (found < batchSize)
+                break;
+            scanFrom = start;
+        }
+        if (start != end)
+            line(start, end);
+    }
+
+    /** Without any \r of a \r\n line ending */
+    std::string_view lineView(const char* p, size_t start, size_t end) noexcept
+    {
+        if (end != start && p[end - 1] == '\r')
+            --end;
+        return std::string_view(p + start, end - start);
+    }
+}
+
+SString8DelimitedTable::SString8DelimitedTable(const std::filesystem::path& path, const SString8DelimitedOptions& options)
+{
+    const auto borrowMapping = options.m_LongValues == SString8LongValues::BORROW_MAPPING;
+    m_File = SString8Detail::MappedFile(path, borrowMapping ? SString8Detail::MappedFile::Access::COPY_ON_WRITE : SString8Detail::MappedFile::Access::READ_ONLY, "SString8DelimitedTable");
+    const auto p = m_File.data();
+    const auto size = m_File.size();
+    size_t begin = 0;
+    if (size >= 3 && memcmp(p, "\xEF\xBB\xBF", 3) == 0)
+        begin = 3;
+    if (begin == size)
+        return;
+
+    // the first line gives the number of columns, and their names if it is the header
+    const auto firstNewline = SString8Detail::Search::findChar(p + begin, size - begin, '\n');
+    const auto firstEnd = (firstNewline == SString8Detail::Search::npos) ? size : begin + firstNewline;
+    const auto columnCount = SString8Detail::forEachField(lineView(p, begin, firstEnd), options.m_Delimiter, [this, &options](size_t, std::string_view name)
+        {
+            m_Names.emplace_back(options.m_Header ? name : std::string_view());
+        });
+    m_Columns.resize(columnCount);
+    if (options.m_Header)
+        begin = std::min(firstEnd + 1U, size);
+
+    // a chunk of whole lines per thread: each chunk but the first starts after a \n
+    const auto bodyBytes = size - begin;
+    auto threadCount = (options.m_ThreadCount == 0) ? std::max(1U, std::thread::hardware_concurrency()) : options.m_ThreadCount;
+    threadCount = std::min(threadCount, bodyBytes / minChunkBytes + 1U);
+    std::vector<size_t> chunkBegins(threadCount + 1U, size);
+    chunkBegins[0] = begin;
+    for (size_t thread = 1; thread < threadCount; ++thread)
+    {
+        const auto nominal = std::max(begin + bodyBytes / threadCount * thread, chunkBegins[thread - 1]);
+        const auto newline = SString8Detail::Search::findChar(p + nominal, size - nominal, '\n');
+        chunkBegins[thread] = (newline == SString8Detail::Search::npos) ? size : nominal + newline + 1U;
+    }
+
+    std::vector<size_t> rowBegins(threadCount + 1U, 0);
+    onThreads(threadCount, [&](size_t thread)
+        {
+            size_t lines = 0;
+            forEachLine(p, chunkBegins[thread], chunkBegins[thread + 1U], [&lines](size_t, size_t) { ++lines; });
+            rowBegins[thread + 1U] = lines;
+        });
+    for (size_t thread = 0; thread < threadCount; ++thread)
+        rowBegins[thread + 1U] += rowBegins[thread];
+    m_RowCount = rowBegins[threadCount];
+
+    // sizing a column writes every entry, so the columns are shared between the threads too
+    onThreads(threadCount, [&](size_t thread)
+        {
+            for (auto column = thread; column < columnCount; column += threadCount)
+                m_Columns[column].resize(m_RowCount);
+        });
+
+    m_Arenas.resize(threadCount);
+    const auto headerLines = options.m_Header ? 1U : 0U;
+    onThreads(threadCount, [&](size_t thread)
+        {
+            auto& arena = m_Arenas[thread];
+            auto row = rowBegins[thread];
+            const auto store = [&](SString8& entry, std::string_view value)
+                {
+                    if (value.size() <= 7 || value.size() > SString8Detail::SString8Data::max_size_borrowed)
+                    {
+                        entry.assign(value);
+                    }
+                    else if (borrowMapping && value.data() + value.size() != p + size)
+                    {
+                        // the delimiter (or line ending) after the value becomes its null terminator.  The value at the very end of the file has none, so goes to the arena
+                        p[value.data() + value.size() - p] = '\0';
+                        entry = SString8::borrow(value);
+                    }
+                    else
+                    {
+                        entry = SString8::borrow(std::string_view(arena.store(value), value.size()));
+                    }
+                };
+            // the delimiters and line endings are found together, so the chunk is scanned once, rather than a call per line
+            const char separators[] = { options.m_Delimiter, '\n' };
+            size_t positions[batchSize];
+            const auto chunkEnd = chunkBegins[thread + 1U];
+            auto start = chunkBegins[thread];
+            size_t column = 0;
+            const auto endValue = [&](size_t end, bool lineEnd)
+                {
+                    auto valueEnd = end;
+                    if (lineEnd && valueEnd != start && p[valueEnd - 1] == '\r')
+                        --valueEnd;
+                    if (column < columnCount)
+                        store(m_Columns[column][row], std::string_view(p + start, valueEnd - start));
+                    ++column;
+                    start = end + 1U;
+                    if (!lineEnd)
+                        return;
+                    if (column > columnCount)
+                    {
+                        throw std::runtime_error("SString8DelimitedTable - line " + std::to_string(row + headerLines + 1U) + " has " + std::to_string(column)
+                            + " values, for " + std::to_string(columnCount) + " columns: " + path.string());
+                    }
+                    column = 0;
+                    ++row;
+                };
+            for (auto scanFrom = start;;)
+            {
+                const auto found = SString8Detail::Search::findAllOf(p + scanFrom, chunkEnd - scanFrom, separators, 2, positions, batchSize);
+                for (size_t i = 0; i < found; ++i)
+                {
+                    const auto position = scanFrom + positions[i];
+                    endValue(position, p[position] == '\n');
+                }
+                if (found < batchSize)
+                    break;
+                scanFrom = start;
+            }
+            // the last line of the file, if it doesn't end with \n
+            if (start != chunkEnd || column != 0)
+                endValue(chunkEnd, true);
+        });
+
+    // nothing refers to the file any more
+    if (!borrowMapping)
+        m_File = SString8Detail::MappedFile();
+}
+
+SString8DelimitedTable::SString8DelimitedTable(SString8DelimitedTable&& rhs) noexcept
+    : m_File(std::move(rhs.m_File))
+    , m_Arenas(std::exchange(rhs.m_Arenas, {}))
+    , m_Names(std::exchange(rhs.m_Names, {}))
+    , m_Columns(std::exchange(rhs.m_Columns, {}))
+    , m_RowCount(std::exchange(rhs.m_RowCount, 0))
+{
+}
+
+// the values go before the arenas and the mapping that they refer to
+SString8DelimitedTable& SString8DelimitedTable::operator=(SString8DelimitedTable&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        m_Columns = std::exchange(rhs.m_Columns, {});
+        m_Names = std::exchange(rhs.m_Names, {});
+        m_RowCount = std::exchange(rhs.m_RowCount, 0);
+        m_Arenas = std::exchange(rhs.m_Arenas, {});
+        m_File = std::move(rhs.m_File);
+    }
+    return *this;
+}
+
+size_t SString8DelimitedTable::columnIndex(std::string_view name) const noexcept
+{
+    const auto found = std::find_if(m_Names.begin(), m_Names.end(), [name](const SString8& columnName) { return std::string_view(columnName) == name; });
+    return static_cast<size_t>(found - m_Names.begin());
+}
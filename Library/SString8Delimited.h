@@ -0,0 +1,72 @@
+#pragma once
+
+#include "SString8.h"
+#include "SString8Arena.h"
+#include "SString8MappedFile.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+/** Where the values of more than 7 chars in an SString8DelimitedTable are kept */
+enum class SString8LongValues
+{
+    ARENA,          // copied back to back into arenas owned by the table, so the file isn't needed once it is loaded
+    BORROW_MAPPING, // left in the mapped file, with the delimiter after each one overwritten by a null terminator (in a private copy of the page, not in the file)
+};
+
+struct SString8DelimitedOptions
+{
+    char m_Delimiter = ',';
+    /** The first line holds the column names */
+    bool m_Header = true;
+    /** 0 for one per hardware thread.  Fewer are used for small files, with at least 1MB of the file per thread */
+    size_t m_ThreadCount = 0;
+    SString8LongValues m_LongValues = SString8LongValues::ARENA;
+};
+
+/**
+A CSV or TSV file loaded into a column of SString8s per field, eg a reference dataset.
+
+The file is memory mapped and split into a chunk of whole lines per thread.  Each thread counts the lines in its chunk, the columns are sized for every row,
+and then each thread splits its own lines (with the same kernels as split_sstring8) straight into the columns at its rows.
+Values of 7 chars or fewer go in the buffer, so most of a typical file is loaded without any allocation per value.
+Values of 8 to 8191 chars are borrowed SString8s, referring either to arenas owned by the table or to the mapped file (see SString8LongValues).
+Longer values get allocations of their own.
+
+Lines end with \n or \r\n, and the last line need not end at all.  No quoting or escaping is done: every delimiter separates two values.
+A row with fewer values than there are columns gets empty strings for the rest, and a row with more is an error.
+A UTF-8 byte order mark at the start of the file is skipped.
+
+The values are read only, and borrowed ones refer to the table: copies of them must not outlive it.
+*/
+class SString8DelimitedTable
+{
+public:
+    /** Load the file.  Throws std::system_error if it can't be mapped, and std::runtime_error if a row has too many values */
+    explicit SString8DelimitedTable(const std::filesystem::path& path, const SString8DelimitedOptions& options = SString8DelimitedOptions()); // test - SString8DelimitedTestLoad
+    // the arenas' chunks and the mapping don't move, so the values stay valid, and the moved from table is left with no columns or rows
+    SString8DelimitedTable(SString8DelimitedTable&& rhs) noexcept; // test - SString8DelimitedTestLoad
+    SString8DelimitedTable& operator=(SString8DelimitedTable&& rhs) noexcept; // test - SString8DelimitedTestLoad
+    SString8DelimitedTable(const SString8DelimitedTable&) = delete;
+    SString8DelimitedTable& operator=(const SString8DelimitedTable&) = delete;
+
+    size_t columnCount() const noexcept { return m_Columns.size(); } // test - SString8DelimitedTestLoad
+    size_t rowCount() const noexcept { return m_RowCount; } // test - SString8DelimitedTestLoad
+
+    /** The column's name from the header, or empty if there is no header */
+    const SString8& name(size_t column) const noexcept { return m_Names[column]; } // test - SString8DelimitedTestLoad
+    /** The index of the first column with this name, or columnCount() if there is none */
+    size_t columnIndex(std::string_view name) const noexcept; // test - SString8DelimitedTestLoad
+    /** A value per row (see the class comment for how long they stay valid) */
+    const std::vector<SString8>& column(size_t column) const noexcept { return m_Columns[column]; } // test - SString8DelimitedTestLoad
+
+private:
+    // declared first so that they are destroyed after the values that refer to them
+    SString8Detail::MappedFile m_File;
+    std::vector<SString8Detail::CharArena> m_Arenas;
+    std::vector<SString8> m_Names;
+    std::vector<std::vector<SString8>> m_Columns;
+    size_t m_RowCount = 0;
+};
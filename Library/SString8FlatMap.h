@@ -0,0 +1,770 @@
+#pragma once
+
+#include "SString8.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define SSTRING8_FLAT_SSE2 1
+#endif
+
+namespace SString8Detail
+{
+    /**
+    One control byte per slot: empty, deleted, or (for a full slot) the low 7 bits of the key's hash.
+    The table keeps a copy of the first groupWidth control bytes after the last one, so a group can be loaded from any slot without wrapping.
+    */
+    struct FlatCtrl
+    {
+        static inline constexpr int8_t empty = -128;
+        static inline constexpr int8_t deleted = -2;
+        static inline constexpr size_t groupWidth = 16;
+
+        /** groupWidth control bytes, matched all at once.  Each match returns a mask with bit i set if byte i matches */
+        struct Group
+        {
+#if defined(SSTRING8_FLAT_SSE2)
+            explicit Group(const int8_t* pCtrl) noexcept
+                : m_Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl)))
+            {}
+            uint32_t match(int8_t h2) const noexcept
+            {
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_Ctrl)));
+            }
+            uint32_t matchEmpty() const noexcept
+            {
+                return match(empty);
+            }
+            uint32_t matchEmptyOrDeleted() const noexcept
+            {
+                // empty and deleted are the only values below -1
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), m_Ctrl)));
+            }
+            __m128i m_Ctrl;
+#else
+            // portable fallback, a byte at a time
+            explicit Group(const int8_t* pCtrl) noexcept
+            {
+                memcpy(m_Ctrl, pCtrl, groupWidth);
+            }
+            uint32_t match(int8_t h2) const noexcept
+            {
+                uint32_t mask = 0;
+                for (size_t i = 0; i != groupWidth; ++i)
+                    mask |= static_cast<uint32_t>(m_Ctrl[i] == h2) << i;
+                return mask;
+            }
+            uint32_t matchEmpty() const noexcept
+            {
+                return match(empty);
+            }
+            uint32_t matchEmptyOrDeleted() const noexcept
+            {
+                uint32_t mask = 0;
+                for (size_t i = 0; i != groupWidth; ++i)
+                    mask |= static_cast<uint32_t>(m_Ctrl[i] < -1) << i;
+                return mask;
+            }
+            int8_t m_Ctrl[groupWidth];
+#endif
+        };
+
+        /** The control bytes of a table with no slots: one group, all empty, so that a lookup needs no special case */
+        static int8_t* emptyGroup() noexcept
+        {
+            alignas(16) static int8_t group[groupWidth] = {
+                empty, empty, empty, empty, empty, empty, empty, empty,
+                empty, empty, empty, empty, empty, empty, empty, empty };
+            return group;
+        }
+    };
+
+    template<class K>
+    inline constexpr bool isFlatLookupKey = std::is_convertible_v<const K&, std::string_view> && !std::is_same_v<K, SString8>;
+
+    struct FlatSetPolicy
+    {
+        using slot_type = SString8;
+        static constexpr bool constIterators = true;
+        static const SString8& key(const slot_type& slot) noexcept { return slot; }
+        static void relocate(slot_type* pDest, slot_type& src) noexcept
+        {
+            new (pDest) slot_type(std::move(src));
+            src.~slot_type();
+        }
+    };
+
+    template<class Mapped>
+    struct FlatMapPolicy
+    {
+        using slot_type = std::pair<const SString8, Mapped>;
+        static constexpr bool constIterators = false;
+        static const SString8& key(const slot_type& slot) noexcept { return slot.first; }
+        static void relocate(slot_type* pDest, slot_type& src)
+        {
+            // moving an SString8 swaps it with an empty buffer, so the old key is left safe to destroy
+            new (pDest) slot_type(std::move(const_cast<SString8&>(src.first)), std::move(src.second));
+            src.~slot_type();
+        }
+    };
+
+    /**
+    Open addressing hash table of SString8 keys, in the style of a Swiss table: a slot array holding the keys (or key/value pairs) directly,
+    and a control byte per slot holding 7 bits of the key's hash, searched 16 at a time.
+    Keys of 7 chars or fewer are always held in the buffer, so looking one up is a hash of a single word and a single word compare, and never reads the heap.
+    Base of SString8FlatMap and SString8FlatSet.
+    */
+    template<class Policy>
+    class FlatTable
+    {
+    public:
+        using key_type = SString8;
+        using value_type = typename Policy::slot_type;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using hasher = SString8Hash;
+        using key_equal = SString8Equal;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        template<bool IsConst>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = typename Policy::slot_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+            using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+            Iterator() noexcept = default;
+
+            template<bool OtherConst>
+                requires (IsConst && !OtherConst)
+            Iterator(const Iterator<OtherConst>& other) noexcept
+                : m_pCtrl(other.m_pCtrl)
+                , m_pCtrlEnd(other.m_pCtrlEnd)
+                , m_pSlot(other.m_pSlot)
+            {}
+
+            reference operator*() const noexcept { return *m_pSlot; }
+            pointer operator->() const noexcept { return m_pSlot; }
+
+            Iterator& operator++() noexcept
+            {
+                ++m_pCtrl;
+                ++m_pSlot;
+                skipEmpty();
+                return *this;
+            }
+            Iterator operator++(int) noexcept
+            {
+                auto result = *this;
+                ++*this;
+                return result;
+            }
+
+            template<bool OtherConst>
+            bool operator==(const Iterator<OtherConst>& rhs) const noexcept
+            {
+                return m_pCtrl == rhs.m_pCtrl;
+            }
+
+        private:
+            friend class FlatTable;
+            template<bool> friend class Iterator;
+
+            Iterator(const int8_t* pCtrl, const int8_t* pCtrlEnd, pointer pSlot) noexcept
+                : m_pCtrl(pCtrl)
+                , m_pCtrlEnd(pCtrlEnd)
+                , m_pSlot(pSlot)
+            {}
+
+            void skipEmpty() noexcept
+            {
+                while (m_pCtrl != m_pCtrlEnd && *m_pCtrl < 0)
+                {
+                    ++m_pCtrl;
+                    ++m_pSlot;
+                }
+            }
+
+            const int8_t* m_pCtrl = nullptr;
+            const int8_t* m_pCtrlEnd = nullptr;
+            pointer m_pSlot = nullptr;
+        };
+
+        using iterator = Iterator<Policy::constIterators>;
+        using const_iterator = Iterator<true>;
+
+        FlatTable() noexcept = default;
+
+        explicit FlatTable(size_type count)
+        {
+            reserve(count);
+        }
+
+        FlatTable(const FlatTable& other)
+        {
+            if (other.m_Size == 0)
+                return;
+            allocate(other.m_Capacity);
+            // take the layout of other (so its deleted slots still keep probe sequences going), but with every slot marked deleted until it is constructed
+            for (size_t i = 0; i != m_Capacity; ++i)
+                setCtrl(i, (other.m_pCtrl[i] == FlatCtrl::empty) ? FlatCtrl::empty : FlatCtrl::deleted);
+            m_GrowthLeft = other.m_GrowthLeft;
+            try
+            {
+                for (size_t i = 0; i != m_Capacity; ++i)
+                {
+                    if (other.m_pCtrl[i] >= 0)
+                    {
+                        new (m_pSlots + i) value_type(other.m_pSlots[i]);
+                        setCtrl(i, other.m_pCtrl[i]);
+                        ++m_Size;
+                    }
+                }
+            }
+            catch (...)
+            {
+                destroyAll();
+                deallocate(m_pCtrl, m_pSlots, m_Capacity);
+                throw;
+            }
+        }
+
+        FlatTable(FlatTable&& other) noexcept
+        {
+            swap(other);
+        }
+
+        FlatTable& operator=(const FlatTable& rhs)
+        {
+            if (this != &rhs)
+            {
+                FlatTable copy(rhs);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        FlatTable& operator=(FlatTable&& rhs) noexcept
+        {
+            FlatTable moved(std::move(rhs));
+            swap(moved);
+            return *this;
+        }
+
+        ~FlatTable()
+        {
+            destroyAll();
+            deallocate(m_pCtrl, m_pSlots, m_Capacity);
+        }
+
+        void swap(FlatTable& rhs) noexcept
+        {
+            std::swap(m_pCtrl, rhs.m_pCtrl);
+            std::swap(m_pSlots, rhs.m_pSlots);
+            std::swap(m_Capacity, rhs.m_Capacity);
+            std::swap(m_Mask, rhs.m_Mask);
+            std::swap(m_Size, rhs.m_Size);
+            std::swap(m_GrowthLeft, rhs.m_GrowthLeft);
+        }
+
+        iterator begin() noexcept { return makeBegin<iterator>(); }
+        const_iterator begin() const noexcept { return makeBegin<const_iterator>(); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        iterator end() noexcept { return iteratorAt(m_Capacity); }
+        const_iterator end() const noexcept { return iteratorAt(m_Capacity); }
+        const_iterator cend() const noexcept { return end(); }
+
+        [[nodiscard]] bool empty() const noexcept { return m_Size == 0; }
+        size_type size() const noexcept { return m_Size; }
+        /** Number of slots.  The table grows when it would otherwise be more than 7/8 full */
+        size_type capacity() const noexcept { return m_Capacity; }
+        float load_factor() const noexcept { return (m_Capacity == 0) ? 0.0f : static_cast<float>(m_Size) / static_cast<float>(m_Capacity); }
+
+        /** Remove every element, keeping the slots */
+        void clear() noexcept
+        {
+            if (m_Capacity == 0)
+                return;
+            destroyAll();
+            memset(m_pCtrl, FlatCtrl::empty, m_Capacity + FlatCtrl::groupWidth);
+            m_Size = 0;
+            m_GrowthLeft = capacityToGrowth(m_Capacity);
+        }
+
+        /** Make room for count elements without further rehashing */
+        void reserve(size_type count)
+        {
+            if (count > m_Size + m_GrowthLeft)
+                resize(growthToCapacity(count));
+        }
+
+        iterator find(const SString8& key) noexcept { return iteratorAt(findIndex(makeLookup(key))); }
+        const_iterator find(const SString8& key) const noexcept { return iteratorAt(findIndex(makeLookup(key))); }
+
+        /** Find by anything convertible to std::string_view (std::string, const char* etc) without building an SString8 */
+        template<class K>
+            requires isFlatLookupKey<K>
+        iterator find(const K& key) noexcept
+        {
+            return iteratorAt(findIndex(makeLookup(key)));
+        }
+        template<class K>
+            requires isFlatLookupKey<K>
+        const_iterator find(const K& key) const noexcept
+        {
+            return iteratorAt(findIndex(makeLookup(key)));
+        }
+
+        bool contains(const SString8& key) const noexcept { return findIndex(makeLookup(key)) != m_Capacity; }
+        template<class K>
+            requires isFlatLookupKey<K>
+        bool contains(const K& key) const noexcept
+        {
+            return findIndex(makeLookup(key)) != m_Capacity;
+        }
+
+        size_type count(const SString8& key) const noexcept { return contains(key) ? 1 : 0; }
+        template<class K>
+            requires isFlatLookupKey<K>
+        size_type count(const K& key) const noexcept
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        size_type erase(const SString8& key) { return eraseLookup(makeLookup(key)); }
+        template<class K>
+            requires isFlatLookupKey<K>
+        size_type erase(const K& key)
+        {
+            return eraseLookup(makeLookup(key));
+        }
+
+        /** Erase the element at pos, which must be valid.  Returns the iterator following it */
+        iterator erase(const_iterator pos)
+        {
+            const auto index = static_cast<size_t>(pos.m_pCtrl - m_pCtrl);
+            eraseAt(index);
+            auto next = iteratorAt(index);
+            next.skipEmpty();
+            return next;
+        }
+
+    protected:
+        /** A key to look for: its hash, its chars, and (if it is 7 chars or fewer) the buffer word an SString8 holding it would have */
+        struct Lookup
+        {
+            uint64_t m_Hash;
+            uint64_t m_Word;
+            const char* m_pData;
+            size_t m_Size;
+        };
+
+        static Lookup makeLookup(const char* p, size_t len) noexcept
+        {
+            if (len <= 7)
+            {
+                const auto word = SString8Data::makeBufferWord(p, len);
+                return { SString8Data::hashWord(word), word, p, len };
+            }
+            return { SString8Data::hashBytes(p, len), 0, p, len };
+        }
+
+        static Lookup makeLookup(const SString8& key) noexcept
+        {
+            const auto& storage = SString8Access::storage(key);
+            const auto [p, len] = storage.getDataAndSize();
+            if (storage.isBuffer())
+            {
+                const auto word = static_cast<uint64_t>(storage.m_Storage.m_pLargeStr);
+                return { SString8Data::hashWord(word), word, p, len };
+            }
+            return makeLookup(p, len);
+        }
+
+        template<class K>
+            requires isFlatLookupKey<K>
+        static Lookup makeLookup(const K& key) noexcept
+        {
+            const std::string_view str(key);
+            return makeLookup(str.data(), str.size());
+        }
+
+        static bool keyEquals(const SString8& key, const Lookup& lookup) noexcept
+        {
+            const auto& storage = SString8Access::storage(key);
+            // keys in the table are in the buffer whenever they are 7 chars or fewer, so a short key is one word compare and a heap key can't match it
+            if (lookup.m_Size <= 7)
+                return storage.m_Storage.m_pLargeStr == lookup.m_Word;
+            return storage.isPtr() && storage.equals(lookup.m_pData, lookup.m_Size);
+        }
+
+        /** The key to store for a key that is being moved in: as it is, unless it is a heap string of 7 chars or fewer, which goes back in the buffer */
+        static SString8 tableKey(SString8&& key, const Lookup& lookup)
+        {
+            if (lookup.m_Size <= 7 && SString8Access::storage(key).isPtr())
+                return SString8(std::string_view(lookup.m_pData, lookup.m_Size));
+            return std::move(key);
+        }
+
+        static SString8 tableKey(const SString8&, const Lookup& lookup)
+        {
+            return SString8(std::string_view(lookup.m_pData, lookup.m_Size));
+        }
+
+        template<class K>
+            requires isFlatLookupKey<K>
+        static SString8 tableKey(const K&, const Lookup& lookup)
+        {
+            return SString8(std::string_view(lookup.m_pData, lookup.m_Size));
+        }
+
+        /**
+        Find the key described by lookup, or if it is not there construct a new element with make(value_type* pSlot).
+        Returns the element and whether it was inserted.
+        */
+        template<class Make>
+        std::pair<iterator, bool> findOrInsert(const Lookup& lookup, Make&& make)
+        {
+            const auto found = findIndex(lookup);
+            if (found != m_Capacity)
+                return { iteratorAt(found), false };
+            if (m_GrowthLeft == 0)
+                growForInsert();
+            const auto index = findFirstNonFull(lookup.m_Hash);
+            make(m_pSlots + index);
+            m_GrowthLeft -= (m_pCtrl[index] == FlatCtrl::empty) ? 1U : 0U; // a deleted slot was already counted
+            setCtrl(index, h2(lookup.m_Hash));
+            ++m_Size;
+            return { iteratorAt(index), true };
+        }
+
+    private:
+        using slot_type = typename Policy::slot_type;
+
+        static int8_t h2(uint64_t hash) noexcept { return static_cast<int8_t>(hash & 0x7FU); }
+
+        static size_t capacityToGrowth(size_t capacity) noexcept { return capacity - capacity / 8U; }
+
+        static size_t growthToCapacity(size_t count) noexcept
+        {
+            size_t capacity = FlatCtrl::groupWidth;
+            while (capacityToGrowth(capacity) < count)
+                capacity *= 2;
+            return capacity;
+        }
+
+        /** Index of the key, or m_Capacity (the end iterator) if it isn't there */
+        size_t findIndex(const Lookup& lookup) const noexcept
+        {
+            const auto tag = h2(lookup.m_Hash);
+            auto offset = static_cast<size_t>(lookup.m_Hash >> 7U) & m_Mask;
+            // triangular steps of whole groups, which visit every group when the number of slots is a power of two
+            for (size_t step = FlatCtrl::groupWidth; ; step += FlatCtrl::groupWidth)
+            {
+                const FlatCtrl::Group group(m_pCtrl + offset);
+                for (auto match = group.match(tag); match != 0; match &= match - 1U)
+                {
+                    const auto index = (offset + static_cast<size_t>(std::countr_zero(match))) & m_Mask;
+                    if (keyEquals(Policy::key(m_pSlots[index]), lookup))
+                        return index;
+                }
+                if (group.matchEmpty() != 0)
+                    return m_Capacity;
+                offset = (offset + step) & m_Mask;
+            }
+        }
+
+        /** The first empty or deleted slot on the probe sequence for hash.  There is always one, as the table is never full */
+        size_t findFirstNonFull(uint64_t hash) const noexcept
+        {
+            auto offset = static_cast<size_t>(hash >> 7U) & m_Mask;
+            for (size_t step = FlatCtrl::groupWidth; ; step += FlatCtrl::groupWidth)
+            {
+                const auto mask = FlatCtrl::Group(m_pCtrl + offset).matchEmptyOrDeleted();
+                if (mask != 0)
+                    return (offset + static_cast<size_t>(std::countr_zero(mask))) & m_Mask;
+                offset = (offset + step) & m_Mask;
+            }
+        }
+
+        /** Set a control byte, and its copy after the end if it is one of the first groupWidth */
+        void setCtrl(size_t index, int8_t ctrl) noexcept
+        {
+            m_pCtrl[index] = ctrl;
+            m_pCtrl[((index - FlatCtrl::groupWidth) & m_Mask) + FlatCtrl::groupWidth] = ctrl;
+        }
+
+        size_type eraseLookup(const Lookup& lookup)
+        {
+            const auto index = findIndex(lookup);
+            if (index == m_Capacity)
+                return 0;
+            eraseAt(index);
+            return 1;
+        }
+
+        void eraseAt(size_t index)
+        {
+            m_pSlots[index].~slot_type();
+            --m_Size;
+            // if no group containing this slot was ever full, no probe sequence has gone past it, so it can become empty rather than deleted
+            const auto emptyBefore = FlatCtrl::Group(m_pCtrl + ((index - FlatCtrl::groupWidth) & m_Mask)).matchEmpty();
+            const auto emptyAfter = FlatCtrl::Group(m_pCtrl + index).matchEmpty();
+            const auto neverFull = emptyBefore != 0 && emptyAfter != 0
+                && static_cast<size_t>(std::countr_zero(emptyAfter)) + static_cast<size_t>(std::countl_zero(emptyBefore << 16U)) < FlatCtrl::groupWidth;
+            if (neverFull)
+            {
+                setCtrl(index, FlatCtrl::empty);
+                ++m_GrowthLeft;
+            }
+            else
+            {
+                setCtrl(index, FlatCtrl::deleted);
+            }
+        }
+
+        /** Make room for one more element: double, or rehash in place if at least half of the used slots are deleted ones */
+        void growForInsert()
+        {
+            if (m_Capacity != 0 && m_Size <= capacityToGrowth(m_Capacity) / 2U)
+                resize(m_Capacity);
+            else
+                resize((m_Capacity == 0) ? FlatCtrl::groupWidth : m_Capacity * 2U);
+        }
+
+        void resize(size_t newCapacity)
+        {
+            auto* const pOldCtrl = m_pCtrl;
+            auto* const pOldSlots = m_pSlots;
+            const auto oldCapacity = m_Capacity;
+            allocate(newCapacity);
+            m_GrowthLeft = capacityToGrowth(newCapacity) - m_Size;
+            for (size_t i = 0; i != oldCapacity; ++i)
+            {
+                if (pOldCtrl[i] < 0)
+                    continue;
+                auto& slot = pOldSlots[i];
+                const auto hash = SString8Access::storage(Policy::key(slot)).hash();
+                const auto index = findFirstNonFull(hash);
+                Policy::relocate(m_pSlots + index, slot);
+                setCtrl(index, h2(hash));
+            }
+            deallocate(pOldCtrl, pOldSlots, oldCapacity);
+        }
+
+        /** Allocate empty slots and control bytes.  Does not free the old ones */
+        void allocate(size_t capacity)
+        {
+            auto pSlots = std::allocator<slot_type>().allocate(capacity);
+            try
+            {
+                m_pCtrl = new int8_t[capacity + FlatCtrl::groupWidth];
+            }
+            catch (...)
+            {
+                std::allocator<slot_type>().deallocate(pSlots, capacity);
+                throw;
+            }
+            m_pSlots = pSlots;
+            memset(m_pCtrl, FlatCtrl::empty, capacity + FlatCtrl::groupWidth);
+            m_Capacity = capacity;
+            m_Mask = capacity - 1U;
+        }
+
+        static void deallocate(int8_t* pCtrl, slot_type* pSlots, size_t capacity) noexcept
+        {
+            if (capacity == 0)
+                return;
+            delete[] pCtrl;
+            std::allocator<slot_type>().deallocate(pSlots, capacity);
+        }
+
+        void destroyAll() noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<slot_type>)
+            {
+                for (size_t i = 0; i != m_Capacity; ++i)
+                {
+                    if (m_pCtrl[i] >= 0)
+                        m_pSlots[i].~slot_type();
+                }
+            }
+        }
+
+        iterator iteratorAt(size_t index) noexcept
+        {
+            return iterator(m_pCtrl + index, m_pCtrl + m_Capacity, m_pSlots + index);
+        }
+        const_iterator iteratorAt(size_t index) const noexcept
+        {
+            return const_iterator(m_pCtrl + index, m_pCtrl + m_Capacity, m_pSlots + index);
+        }
+
+        template<class It>
+        It makeBegin() const noexcept
+        {
+            It it(m_pCtrl, m_pCtrl + m_Capacity, m_pSlots);
+            it.skipEmpty();
+            return it;
+        }
+
+        int8_t* m_pCtrl = FlatCtrl::emptyGroup();
+        slot_type* m_pSlots = nullptr;
+        size_t m_Capacity = 0; // 0, or a power of two of at least groupWidth
+        size_t m_Mask = 0;
+        size_t m_Size = 0;
+        size_t m_GrowthLeft = 0;
+    };
+} // namespace detail
+
+/**
+Hash map from SString8 to Mapped, an open addressing (Swiss table style) alternative to std::unordered_map<SString8, Mapped, SString8Hash, SString8Equal>.
+Elements are held directly in one slot array, so there is no allocation per element and a key of 7 chars or fewer is found without reading any memory other than the slot.
+Anything convertible to std::string_view can be used to look up, insert or erase without building an SString8 (one is only built when a new key is inserted).
+As with the Swiss table, any insert may move the elements, invalidating iterators, pointers and references to them.
+*/
+template<class Mapped>
+class SString8FlatMap : public SString8Detail::FlatTable<SString8Detail::FlatMapPolicy<Mapped>>
+{
+    using Base = SString8Detail::FlatTable<SString8Detail::FlatMapPolicy<Mapped>>;
+
+public:
+    using mapped_type = Mapped;
+    using typename Base::value_type;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+
+    using Base::Base;
+
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(const SString8& key, Args&&... args) // test - SString8FlatMapTestInsert
+    {
+        return tryEmplace(key, std::forward<Args>(args)...);
+    }
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(SString8&& key, Args&&... args) // test - SString8FlatMapTestInsert
+    {
+        return tryEmplace(std::move(key), std::forward<Args>(args)...);
+    }
+    template<class K, class... Args>
+        requires SString8Detail::isFlatLookupKey<K>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) // test - SString8FlatMapTestHeterogeneous
+    {
+        return tryEmplace(key, std::forward<Args>(args)...);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) // test - SString8FlatMapTestInsert
+    {
+        return try_emplace(value.first, value.second);
+    }
+    std::pair<iterator, bool> insert(value_type&& value) // test - SString8FlatMapTestInsert
+    {
+        return try_emplace(std::move(const_cast<SString8&>(value.first)), std::move(value.second));
+    }
+
+    template<class K, class M>
+    std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj) // test - SString8FlatMapTestInsert
+    {
+        auto result = try_emplace(std::forward<K>(key), std::forward<M>(obj));
+        if (!result.second)
+            result.first->second = std::forward<M>(obj);
+        return result;
+    }
+
+    Mapped& operator[](const SString8& key) { return try_emplace(key).first->second; } // test - SString8FlatMapTestInsert
+    Mapped& operator[](SString8&& key) { return try_emplace(std::move(key)).first->second; } // test - SString8FlatMapTestInsert
+    template<class K>
+        requires SString8Detail::isFlatLookupKey<K>
+    Mapped& operator[](const K& key) // test - SString8FlatMapTestHeterogeneous
+    {
+        return try_emplace(key).first->second;
+    }
+
+    Mapped& at(const SString8& key) { return atImpl(*this, key); } // test - SString8FlatMapTestFind
+    const Mapped& at(const SString8& key) const { return atImpl(*this, key); } // test - SString8FlatMapTestFind
+    template<class K>
+        requires SString8Detail::isFlatLookupKey<K>
+    Mapped& at(const K& key) // test - SString8FlatMapTestHeterogeneous
+    {
+        return atImpl(*this, key);
+    }
+    template<class K>
+        requires SString8Detail::isFlatLookupKey<K>
+    const Mapped& at(const K& key) const // test - SString8FlatMapTestHeterogeneous
+    {
+        return atImpl(*this, key);
+    }
+
+private:
+    template<class K, class... Args>
+    std::pair<iterator, bool> tryEmplace(K&& key, Args&&... args)
+    {
+        const auto lookup = Base::makeLookup(key);
+        return Base::findOrInsert(lookup, [&](value_type* pSlot)
+            {
+                new (pSlot) value_type(std::piecewise_construct,
+                    std::forward_as_tuple(Base::tableKey(std::forward<K>(key), lookup)),
+                    std::forward_as_tuple(std::forward<Args>(args)...));
+            });
+    }
+
+    template<class Self, class K>
+    static auto& atImpl(Self& self, const K& key)
+    {
+        const auto it = self.find(key);
+        if (it == self.end())
+            throw std::out_of_range("SString8FlatMap::at - key not found");
+        return it->second;
+    }
+};
+
+/** Hash set of SString8, the SString8FlatMap equivalent of std::unordered_set.  Elements can't be changed through its iterators */
+class SString8FlatSet : public SString8Detail::FlatTable<SString8Detail::FlatSetPolicy>
+{
+    using Base = SString8Detail::FlatTable<SString8Detail::FlatSetPolicy>;
+
+public:
+    using Base::Base;
+
+    std::pair<iterator, bool> insert(const SString8& key) // test - SString8FlatSetTest
+    {
+        return insertImpl(key);
+    }
+    std::pair<iterator, bool> insert(SString8&& key) // test - SString8FlatSetTest
+    {
+        return insertImpl(std::move(key));
+    }
+    template<class K>
+        requires SString8Detail::isFlatLookupKey<K>
+    std::pair<iterator, bool> insert(const K& key) // test - SString8FlatSetTest
+    {
+        return insertImpl(key);
+    }
+
+private:
+    template<class K>
+    std::pair<iterator, bool> insertImpl(K&& key)
+    {
+        const auto lookup = makeLookup(key);
+        return findOrInsert(lookup, [&](SString8* pSlot)
+            {
+                new (pSlot) SString8(tableKey(std::forward<K>(key), lookup));
+            });
+    }
+};
@@ -0,0 +1,49 @@
+#include "SString8InternPool.h"
+
+#include <mutex>
+#include <utility>
+
+SString8 SString8InternPool::intern(std::string_view str)
+{
+    if (str.size() <= 7)
+        return SString8(str);
+    const auto hash = SString8Hash()(str);
+    // the set uses the low bits of the same hash, so the shard is chosen with the top bits
+    auto& shard = m_Shards[hash >> (64U - shardBits)];
+    {
+        const std::shared_lock<std::shared_mutex> lock(shard.m_Mutex);
+        if (const auto it = shard.m_Strings.find(str); it != shard.m_Strings.end())
+            return *it;
+    }
+    const std::unique_lock<std::shared_mutex> lock(shard.m_Mutex);
+    // another thread may have added it between the locks
+    if (const auto it = shard.m_Strings.find(str); it != shard.m_Strings.end())
+        return *it;
+    auto stored = (str.size() <= SString8Detail::SString8Data::max_size_borrowed)
+        ? SString8::borrow(std::string_view(shard.m_Arena.store(str), str.size()))
+        : SString8(str);
+    // moved in, as the set would copy the chars of a key passed by reference
+    return *shard.m_Strings.insert(std::move(stored)).first;
+}
+
+size_t SString8InternPool::size() const
+{
+    size_t total = 0;
+    for (const auto& shard : m_Shards)
+    {
+        const std::shared_lock<std::shared_mutex> lock(shard.m_Mutex);
+        total += shard.m_Strings.size();
+    }
+    return total;
+}
+
+size_t SString8InternPool::arenaBytes() const
+{
+    size_t total = 0;
+    for (const auto& shard : m_Shards)
+    {
+        const std::shared_lock<std::shared_mutex> lock(shard.m_Mutex);
+        total += shard.m_Arena.usedBytes();
+    }
+    return total;
+}
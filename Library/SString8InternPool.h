@@ -0,0 +1,72 @@
+#pragma once
+
+#include "SString8.h"
+#include "SString8Arena.h"
+#include "SString8FlatMap.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string_view>
+
+/**
+Hands out SString8s for symbol-like strings (host names, metric names, ...) that are made over and over, so that each distinct value is held once.
+
+Strings of 7 chars or fewer are buffer strings, which need nothing from the pool.
+Strings of 8 to 8191 chars are copied once into the pool's arena, and every intern of the same chars returns a borrowed SString8 referring to that copy,
+so interning allocates nothing once a value has been seen, copying an interned string copies 8 bytes, and two interned strings are equal exactly when their words are (see equal).
+Longer strings are held as SString8s in the pool; with SSTRING8_SHARED_PAYLOAD their copies share the allocation, otherwise each intern returns a copy of its own.
+
+The table is split into shards, each with its own reader/writer lock, chosen by the top bits of the hash, so that threads interning different strings rarely meet,
+and threads interning strings that are already there only take the lock shared.
+
+The pool must outlive every string it has returned (which refer to its arena), and it never forgets a string.  intern may be called from any number of threads at once.
+*/
+class SString8InternPool
+{
+public:
+    SString8InternPool() = default;
+    SString8InternPool(const SString8InternPool&) = delete;
+    SString8InternPool& operator=(const SString8InternPool&) = delete;
+
+    /** The pool's string with these chars, adding it if it isn't there yet */
+    SString8 intern(std::string_view str); // test - SString8InternPoolTestIntern
+
+    /**
+    For two strings returned by the same pool: whether they are equal, from their words alone, without reading their chars.
+    Strings too long to borrow are compared as usual, unless SSTRING8_SHARED_PAYLOAD is set, where their copies share a word too.
+    */
+    static bool equal(const SString8& lhs, const SString8& rhs) noexcept // test - SString8InternPoolTestIntern
+    {
+        using Data = SString8Detail::SString8Data;
+        const auto lhsWord = SString8Detail::SString8Access::storage(lhs).m_Storage.m_pLargeStr;
+        const auto rhsWord = SString8Detail::SString8Access::storage(rhs).m_Storage.m_pLargeStr;
+        if (lhsWord == rhsWord)
+            return true;
+        if constexpr (!Data::shared_payload)
+        {
+            // neither is a buffer or borrowed string, so both are longer than 8191 chars
+            if ((lhsWord & rhsWord & Data::top) != 0 && (lhsWord & 0b11U) != Data::borrowed_lower_bits && (rhsWord & 0b11U) != Data::borrowed_lower_bits)
+                return lhs == rhs;
+        }
+        return false;
+    }
+
+    /** The number of distinct strings of 8 chars or more in the pool */
+    size_t size() const; // test - SString8InternPoolTestIntern
+    /** Bytes of arena that hold the chars of the pool's strings, with their null terminators (not including the tables, or strings too long to borrow) */
+    size_t arenaBytes() const; // test - SString8InternPoolTestIntern
+
+private:
+    static inline constexpr size_t shardBits = 6;
+    static inline constexpr size_t shardCount = size_t(1) << shardBits;
+
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex m_Mutex;
+        SString8FlatSet m_Strings;
+        SString8Detail::CharArena m_Arena;
+    };
+
+    Shard m_Shards[shardCount];
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "SString8.h"
+#include "SString8MappedFile.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <utility>
+
+/**
+Reads the lines of text in memory, or of a memory mapped file, without going through an istream.
+The line endings are found a batch at a time with Search::findAllChar, so short lines cost a few chars' worth of a block scan each, rather than a streambuf call per char.
+
+As std::getline, a line is everything up to the next delim, which is not included (so a \r of a \r\n line ending is kept),
+and the last line need not end with delim.
+*/
+class SString8LineReader
+{
+public:
+    /** The lines of text, which must stay valid for as long as the lines read from it are used */
+    explicit SString8LineReader(std::string_view text, char delim = '\n') noexcept // test - SString8LineReaderTestText
+        : m_Text(text)
+        , m_Delim(delim)
+    {
+    }
+
+    /** The lines of the file, memory mapped read only (a named function, as a std::string would convert to both a path and text).  Throws std::system_error if it can't be mapped */
+    static SString8LineReader fromFile(const std::filesystem::path& path, char delim = '\n') // test - SString8LineReaderTestFile
+    {
+        return SString8LineReader(SString8Detail::MappedFile(path, SString8Detail::MappedFile::Access::READ_ONLY, "SString8LineReader"), delim);
+    }
+
+    // the mapping doesn't move, so the text and the lines read from it stay valid
+    SString8LineReader(SString8LineReader&&) noexcept = default;
+    SString8LineReader& operator=(SString8LineReader&&) noexcept = default;
+    SString8LineReader(const SString8LineReader&) = delete;
+    SString8LineReader& operator=(const SString8LineReader&) = delete;
+
+    /** The next line, in place in the text.  False once there are no more */
+    bool getline(std::string_view& line) noexcept // test - SString8LineReaderTestText
+    {
+        if (m_Next == m_Found)
+        {
+            if (m_Pos == m_Text.size())
+                return false;
+            if (!m_LastBatch)
+            {
+                m_ScanFrom = m_Pos;
+                m_Found = SString8Detail::Search::findAllChar(m_Text.data() + m_Pos, m_Text.size() - m_Pos, m_Delim, m_Positions, batchSize);
+                m_Next = 0;
+                m_LastBatch = m_Found < batchSize;
+            }
+            if (m_Next == m_Found)
+            {
+                // no delimiter after the last one: the rest is the last line
+                line = m_Text.substr(m_Pos);
+                m_Pos = m_Text.size();
+                return true;
+            }
+        }
+        const auto end = m_ScanFrom + m_Positions[m_Next++];
+        line = m_Text.substr(m_Pos, end - m_Pos);
+        m_Pos = end + 1U;
+        return true;
+    }
+
+    /** The next line, assigned to line, which keeps its existing storage (so a line of 7 chars or fewer goes in the buffer of a buffer string) */
+    template<class Alloc>
+    bool getline(basic_SString8<Alloc>& line) // test - SString8LineReaderTestText
+    {
+        std::string_view view;
+        if (!getline(view))
+            return false;
+        line.assign(view);
+        return true;
+    }
+
+private:
+    static inline constexpr size_t batchSize = 256;
+
+    SString8LineReader(SString8Detail::MappedFile&& file, char delim) noexcept
+        : m_File(std::move(file))
+        , m_Text(m_File.data(), m_File.size())
+        , m_Delim(delim)
+    {
+    }
+
+    // declared first, as m_Text refers to it
+    SString8Detail::MappedFile m_File;
+    std::string_view m_Text;
+    char m_Delim;
+    size_t m_Pos = 0;
+    // the delimiters found by the last scan, relative to m_ScanFrom, of which m_Next is the next to use
+    size_t m_ScanFrom = 0;
+    size_t m_Found = 0;
+    size_t m_Next = 0;
+    // the last scan reached the end of the text
+    bool m_LastBatch = false;
+    size_t m_Positions[batchSize];
+};
@@ -0,0 +1,111 @@
+#include "SString8MappedFile.h"
+
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// the file itself is closed again once it is mapped, as the mapping keeps it open
+SString8Detail::MappedFile::MappedFile(const std::filesystem::path& path, Access access, const char* what)
+{
+    const auto copyOnWrite = access == Access::COPY_ON_WRITE;
+#if defined(_WIN32)
+    const auto hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+        throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), std::string(what) + " - can't open " + path.string());
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize))
+    {
+        const auto error = GetLastError();
+        CloseHandle(hFile);
+        throw std::system_error(static_cast<int>(error), std::system_category(), std::string(what) + " - can't open " + path.string());
+    }
+    if (fileSize.QuadPart == 0)
+    {
+        CloseHandle(hFile);
+        return;
+    }
+    const auto hMapping = CreateFileMappingW(hFile, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+    const auto error = GetLastError();
+    CloseHandle(hFile);
+    if (!hMapping)
+        throw std::system_error(static_cast<int>(error), std::system_category(), std::string(what) + " - can't map " + path.string());
+    const auto p = MapViewOfFile(hMapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    const auto mapError = GetLastError();
+    CloseHandle(hMapping);
+    if (!p)
+        throw std::system_error(static_cast<int>(mapError), std::system_category(), std::string(what) + " - can't map " + path.string());
+    m_p = static_cast<char*>(p);
+    m_Size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), std::string(what) + " - can't open " + path.string());
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        const auto error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), std::string(what) + " - can't open " + path.string());
+    }
+    if (st.st_size == 0)
+    {
+        close(fd);
+        return;
+    }
+    const auto size = static_cast<size_t>(st.st_size);
+    const auto p = copyOnWrite ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0) : mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    const auto error = errno;
+    close(fd);
+    if (p == MAP_FAILED)
+        throw std::system_error(error, std::generic_category(), std::string(what) + " - can't map " + path.string());
+    m_p = static_cast<char*>(p);
+    m_Size = size;
+#endif
+}
+
+SString8Detail::MappedFile::MappedFile(MappedFile&& rhs) noexcept
+    : m_p(std::exchange(rhs.m_p, nullptr))
+    , m_Size(std::exchange(rhs.m_Size, 0))
+{
+}
+
+SString8Detail::MappedFile& SString8Detail::MappedFile::operator=(MappedFile&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        unmap();
+        m_p = std::exchange(rhs.m_p, nullptr);
+        m_Size = std::exchange(rhs.m_Size, 0);
+    }
+    return *this;
+}
+
+SString8Detail::MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+void SString8Detail::MappedFile::unmap() noexcept
+{
+    if (!m_p)
+        return;
+#if defined(_WIN32)
+    UnmapViewOfFile(m_p);
+#else
+    munmap(m_p, m_Size);
+#endif
+    m_p = nullptr;
+    m_Size = 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace SString8Detail
+{
+    /**
+    The whole of a file, memory mapped (used by SString8TableView and SString8DelimitedTable).
+    READ_ONLY shares the file's pages.  COPY_ON_WRITE can also be written to, eg to null terminate values in place so that SString8s can borrow them,
+    and a page that is written to becomes a private copy, so the file itself is never changed.
+    An empty file is not mapped, and gives a null data() and a size() of 0.
+    */
+    class MappedFile
+    {
+    public:
+        enum class Access { READ_ONLY, COPY_ON_WRITE };
+
+        MappedFile() = default;
+        /** Throws std::system_error if the file can't be opened or mapped.  what is put at the front of the error message */
+        MappedFile(const std::filesystem::path& path, Access access, const char* what);
+        MappedFile(MappedFile&& rhs) noexcept;
+        MappedFile& operator=(MappedFile&& rhs) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        /** Only to be written to with COPY_ON_WRITE */
+        char* data() const noexcept { return m_p; }
+        size_t size() const noexcept { return m_Size; }
+
+    private:
+        void unmap() noexcept;
+
+        char* m_p = nullptr;
+        size_t m_Size = 0;
+    };
+}
@@ -0,0 +1,129 @@
+#include "SString8Search.h"
+#include "SString8SearchKernels.h"
+
+#include <atomic>
+#include <initializer_list>
+
+#if defined(_MSC_VER) && defined(SSTRING8_SEARCH_X86)
+#include <immintrin.h> // _xgetbv
+#endif
+
+namespace
+{
+    using SString8Detail::Search::Level;
+
+    constexpr Kernels scalarKernels = kernelsFor<Word>();
+#if defined(SSTRING8_SEARCH_X86)
+    constexpr Kernels sse2Kernels = kernelsFor<Sse2>();
+#endif
+
+    bool hasAvx2() noexcept
+    {
+#if defined(SSTRING8_SEARCH_X86) && defined(_MSC_VER)
+        // the CPU has AVX (and the OS saves the ymm registers), and has AVX2
+        int info[4];
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6U) != 6U)
+            return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#elif defined(SSTRING8_SEARCH_X86)
+        // checks the OS support as well as the CPU
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+    const Kernels& kernelsAt(Level level) noexcept
+    {
+        switch (level)
+        {
+#if defined(SSTRING8_SEARCH_X86)
+        case Level::AVX2:
+            return SString8Detail::Search::avx2Kernels();
+        case Level::SSE2:
+            return sse2Kernels;
+#endif
+        default:
+            return scalarKernels;
+        }
+    }
+
+    // null until the first search, which picks the best level.  Constant initialised, so searching from a static initialiser is fine
+    std::atomic<const Kernels*> g_pKernels{ nullptr };
+
+    const Kernels& kernels() noexcept
+    {
+        auto pKernels = g_pKernels.load(std::memory_order_relaxed);
+        if (!pKernels)
+        {
+            pKernels = &kernelsAt(SString8Detail::Search::bestLevel());
+            g_pKernels.store(pKernels, std::memory_order_relaxed);
+        }
+        return *pKernels;
+    }
+}
+
+size_t SString8Detail::Search::rfindChar(const char* p, size_t len, char ch) noexcept
+{
+    return kernels().m_RfindChar(p, len, ch);
+}
+
+size_t SString8Detail::Search::findLong(const char* p, size_t len, const char* pNeedle, size_t needleLen) noexcept
+{
+    return kernels().m_Find(p, len, pNeedle, needleLen);
+}
+
+size_t SString8Detail::Search::rfind(const char* p, size_t len, const char* pNeedle, size_t needleLen) noexcept
+{
+    return kernels().m_Rfind(p, len, pNeedle, needleLen);
+}
+
+size_t SString8Detail::Search::findOf(const char* p, size_t len, const char* pSet, size_t setLen, bool notOf) noexcept
+{
+    return kernels().m_FindOf(p, len, pSet, setLen, notOf);
+}
+
+size_t SString8Detail::Search::rfindOf(const char* p, size_t len, const char* pSet, size_t setLen, bool notOf) noexcept
+{
+    return kernels().m_RfindOf(p, len, pSet, setLen, notOf);
+}
+
+size_t SString8Detail::Search::findAllChar(const char* p, size_t len, char ch, size_t* pPositions, size_t maxPositions) noexcept
+{
+    return kernels().m_FindAllChar(p, len, ch, pPositions, maxPositions);
+}
+
+size_t SString8Detail::Search::findAllOf(const char* p, size_t len, const char* pSet, size_t setLen, size_t* pPositions, size_t maxPositions) noexcept
+{
+    return kernels().m_FindAllOf(p, len, pSet, setLen, pPositions, maxPositions);
+}
+
+SString8Detail::Search::Level SString8Detail::Search::bestLevel() noexcept
+{
+#if defined(SSTRING8_SEARCH_X86)
+    static const auto best = hasAvx2() ? Level::AVX2 : Level::SSE2;
+    return best;
+#else
+    return Level::SCALAR;
+#endif
+}
+
+SString8Detail::Search::Level SString8Detail::Search::level() noexcept
+{
+    const auto& current = kernels();
+    for (const auto candidate : { Level::AVX2, Level::SSE2 })
+    {
+        if (candidate <= bestLevel() && &kernelsAt(candidate) == &current)
+            return candidate;
+    }
+    return Level::SCALAR;
+}
+
+void SString8Detail::Search::setLevel(Level level) noexcept
+{
+    if (level > bestLevel())
+        level = bestLevel();
+    g_pKernels.store(&kernelsAt(level), std::memory_order_relaxed);
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+Search kernels for the find family of SString8, over len chars at p.  Each returns an index into p, or npos when there is no match.
+
+A string of 7 chars or fewer is searched in its buffer word by SString8 itself, with the SWAR helpers below (no call, and no memory read).
+Longer strings come here.  A char, and a substring of up to maxShortNeedle chars (the usual tokens and keys), are found inline with memchr, which libc already has tuned for each CPU,
+comparing the rest of a substring as two words where its first char is.  At field lengths the call through a kernel table would cost more than the search.
+Everything else goes to kernels for the best instruction set that the CPU has (AVX2, then SSE2, then 8 bytes at a time in a word), picked at run time on first use.
+Searching for a longer substring looks for its first and last chars together a block at a time, and compares the rest only where both match.
+Sets of up to 4 chars (eg delimiters) are searched for a block at a time, larger sets a char at a time with a 256 bit table.
+*/
+namespace SString8Detail
+{
+    namespace Search
+    {
+        static inline constexpr size_t npos = ~size_t(0);
+
+        /** Substrings of up to this many chars are found with memchr rather than the kernels */
+        static inline constexpr size_t maxShortNeedle = 8;
+
+        /** The first index of ch */
+        inline size_t findChar(const char* p, size_t len, char ch) noexcept
+        {
+            const auto pFound = (len == 0) ? nullptr : static_cast<const char*>(memchr(p, ch, len));
+            return pFound ? static_cast<size_t>(pFound - p) : npos;
+        }
+
+        /** The last index of ch */
+        size_t rfindChar(const char* p, size_t len, char ch) noexcept;
+
+        /** The sizeof(T) chars at p, as a T */
+        template<class T>
+        inline T loadAs(const char* p) noexcept
+        {
+            T value;
+            memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        /** find for needles of sizeof(Half) to 2 * sizeof(Half) chars, whose first and last sizeof(Half) chars are compared where memchr finds the first char */
+        template<class Half>
+        inline size_t findShort(const char* p, size_t len, const char* pNeedle, size_t needleLen) noexcept
+        {
+            const auto tail = needleLen - sizeof(Half);
+            const auto needleHead = loadAs<Half>(pNeedle);
+            const auto needleTail = loadAs<Half>(pNeedle + tail);
+            // the last place that the needle can start, so every load below is within the len chars
+            const auto pEnd = p + (len - needleLen + 1U);
+            for (auto pFrom = p; pFrom != pEnd;)
+            {
+                const auto pHit = static_cast<const char*>(memchr(pFrom, pNeedle[0], static_cast<size_t>(pEnd - pFrom)));
+                if (!pHit)
+                    return npos;
+                if (loadAs<Half>(pHit) == needleHead && loadAs<Half>(pHit + tail) == needleTail)
+                    return static_cast<size_t>(pHit - p);
+                pFrom = pHit + 1;
+            }
+            return npos;
+        }
+
+        /** find for needles of more than maxShortNeedle chars, with the kernels */
+        size_t findLong(const char* p, size_t len, const char* pNeedle, size_t needleLen) noexcept;
+
+        /** The first index at which the needleLen (at least 1) chars at pNeedle start */
+        inline size_t find(const char* p, size_t len, const char* pNeedle, size_t needleLen) noexcept
+        {
+            if (needleLen > len)
+                return npos;
+            if (needleLen == 1)
+                return findChar(p, len, pNeedle[0]);
+            if (needleLen < 4)
+                return findShort<uint16_t>(p, len, pNeedle, needleLen);
+            if (needleLen <= maxShortNeedle)
+                return findShort<uint32_t>(p, len, pNeedle, needleLen);
+            return findLong(p, len, pNeedle, needleLen);
+        }
+
+        /** The last index at which the needleLen (at least 1) chars at pNeedle start */
+        size_t rfind(const char* p, size_t len, const char* pNeedle, size_t needleLen) noexcept;
+
+        /** The first and last index of a char that is one of the setLen chars at pSet, or with notOf, that is not one of them */
+        size_t findOf(const char* p, size_t len, const char* pSet, size_t setLen, bool notOf) noexcept;
+        size_t rfindOf(const char* p, size_t len, const char* pSet, size_t setLen, bool notOf) noexcept;
+
+        /**
+        The indices of ch, in order, up to maxPositions of them, written to pPositions.  Gives how many were written.
+        When that is maxPositions there may be more, so carry on from after the last one (eg to split a record a batch of delimiters at a time)
+        */
+        size_t findAllChar(const char* p, size_t len, char ch, size_t* pPositions, size_t maxPositions) noexcept;
+        /** As findAllChar, for the chars that are one of the setLen chars at pSet (eg a delimiter and \n, to split a file into rows and values in one pass) */
+        size_t findAllOf(const char* p, size_t len, const char* pSet, size_t setLen, size_t* pPositions, size_t maxPositions) noexcept;
+
+        /** The instruction sets that the kernels are built for.  SCALAR works on 8 byte words, so is still not a char at a time */
+        enum class Level { SCALAR, SSE2, AVX2 };
+        /** The best level that this CPU supports */
+        Level bestLevel() noexcept;
+        /** The level in use */
+        Level level() noexcept;
+        /** Use level (or bestLevel() if that is lower) from now on, eg to test or benchmark each set of kernels */
+        void setLevel(Level level) noexcept; // test - SString8SearchTestLevels
+
+        // SWAR (SIMD within a register) on a buffer string's word, which holds char i in byte i
+
+        /** Each byte of ch */
+        static constexpr uint64_t broadcast(char ch) noexcept
+        {
+            return 0x0101010101010101ULL * static_cast<uint8_t>(ch);
+        }
+
+        /**
+        0x80 in each byte of word that is 0, and 0 in every other bit.
+        Exact, unlike the usual (word - 0x01...) & ~word & 0x80..., which can also flag the byte above a 0 byte, so it is also right for the last match.
+        */
+        static constexpr uint64_t zeroBytes(uint64_t word) noexcept
+        {
+            constexpr auto low7 = 0x7F7F7F7F7F7F7F7FULL;
+            return ~(((word & low7) + low7) | word | low7);
+        }
+
+        /** 0x80 in bytes [first, last), where first <= last <= 7 */
+        static constexpr uint64_t lanes(size_t first, size_t last) noexcept
+        {
+            return ((1ULL << (8U * last)) - (1ULL << (8U * first))) & 0x8080808080808080ULL;
+        }
+    }
+}
@@ -0,0 +1,29 @@
+// Compiled with AVX2 enabled (-mavx2 on GCC and Clang), so nothing here may run until SString8Search.cpp has checked that the CPU has it
+#include "SString8SearchKernels.h"
+
+#if defined(SSTRING8_SEARCH_X86)
+#include <immintrin.h>
+
+namespace
+{
+    /** 32 chars */
+    struct Avx2
+    {
+        static constexpr size_t width = 32;
+        static constexpr unsigned bitsPerChar = 1;
+        static constexpr uint64_t allMask = 0xFFFFFFFFU;
+        using Value = __m256i;
+        using Narrower = Sse2;
+        static Value load(const char* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static Value broadcast(char ch) noexcept { return _mm256_set1_epi8(ch); }
+        static uint64_t eq(Value v, Value b) noexcept { return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, b))); }
+    };
+
+    constexpr Kernels avx2KernelTable = kernelsFor<Avx2>();
+}
+
+const SString8Detail::Search::Kernels& SString8Detail::Search::avx2Kernels() noexcept
+{
+    return avx2KernelTable;
+}
+#endif
@@ -0,0 +1,391 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SSTRING8_SEARCH_X86
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SSTRING8_SEARCH_INLINE __forceinline
+#else
+// the scan loops are only fast once inlined into their kernel, with the matcher's state in registers
+#define SSTRING8_SEARCH_INLINE __attribute__((always_inline)) inline
+#endif
+
+/**
+The kernels behind SString8Detail::Search (see SString8Search.h), written once over a Vec of Vec::width chars and instantiated for each instruction set.
+Only for SString8Search.cpp and SString8SearchAvx2.cpp, the second of which is compiled for AVX2.
+Apart from Kernels, everything here is in an anonymous namespace, so a function compiled for AVX2 can't be linked in place of the same function compiled without it.
+
+A Vec provides
+    load(p)         the width chars at p, which need not be aligned
+    broadcast(ch)   ch in every lane
+    eq(v, b)        a mask of the lanes in which v and b are equal, bitsPerChar bits per lane, of which only the top one may be set
+    allMask         the mask with every lane set
+    Narrower        the Vec to use for fewer than width chars (apart from Bytes, which is one char)
+*/
+namespace SString8Detail
+{
+    namespace Search
+    {
+        /** The kernels for one instruction set, as function pointers so that the set can be picked at run time.  findChar, and find for short needles, are memchr (see SString8Search.h) */
+        struct Kernels
+        {
+            size_t(*m_RfindChar)(const char* p, size_t len, char ch) noexcept;
+            size_t(*m_Find)(const char* p, size_t len, const char* pNeedle, size_t needleLen) noexcept;
+            size_t(*m_Rfind)(const char* p, size_t len, const char* pNeedle, size_t needleLen) noexcept;
+            size_t(*m_FindOf)(const char* p, size_t len, const char* pSet, size_t setLen, bool notOf) noexcept;
+            size_t(*m_RfindOf)(const char* p, size_t len, const char* pSet, size_t setLen, bool notOf) noexcept;
+            size_t(*m_FindAllChar)(const char* p, size_t len, char ch, size_t* pPositions, size_t maxPositions) noexcept;
+            size_t(*m_FindAllOf)(const char* p, size_t len, const char* pSet, size_t setLen, size_t* pPositions, size_t maxPositions) noexcept;
+        };
+
+#if defined(SSTRING8_SEARCH_X86)
+        /** In SString8SearchAvx2.cpp.  Only to be called if the CPU has AVX2 */
+        const Kernels& avx2Kernels() noexcept;
+#endif
+    }
+}
+
+namespace
+{
+    using SString8Detail::Search::Kernels;
+
+    constexpr size_t kernelNpos = ~size_t(0);
+    // sets with more chars than this are searched with a table, a char at a time
+    constexpr size_t maxVecSetSize = 4;
+
+    inline unsigned lowestBit(uint64_t mask) noexcept
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return index;
+#else
+        return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+    }
+
+    inline unsigned highestBit(uint64_t mask) noexcept
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, mask);
+        return index;
+#else
+        return 63U - static_cast<unsigned>(__builtin_clzll(mask));
+#endif
+    }
+
+    /** One char */
+    struct Bytes
+    {
+        static constexpr size_t width = 1;
+        static constexpr unsigned bitsPerChar = 1;
+        static constexpr uint64_t allMask = 1;
+        using Value = uint8_t;
+        static Value load(const char* p) noexcept { return static_cast<uint8_t>(*p); }
+        static Value broadcast(char ch) noexcept { return static_cast<uint8_t>(ch); }
+        static uint64_t eq(Value v, Value b) noexcept { return v == b; }
+    };
+
+    /** 8 chars in a 64 bit word (SWAR) */
+    struct Word
+    {
+        static constexpr size_t width = 8;
+        static constexpr unsigned bitsPerChar = 8;
+        static constexpr uint64_t allMask = 0x8080808080808080ULL;
+        using Value = uint64_t;
+        using Narrower = Bytes;
+        static Value load(const char* p) noexcept
+        {
+            uint64_t word;
+            memcpy(&word, p, sizeof(word));
+            return word;
+        }
+        static Value broadcast(char ch) noexcept { return 0x0101010101010101ULL * static_cast<uint8_t>(ch); }
+        /** The top bit of each byte that is the same in both, exactly (see SString8Detail::Search::zeroBytes) */
+        static uint64_t eq(Value v, Value b) noexcept
+        {
+            constexpr auto low7 = 0x7F7F7F7F7F7F7F7FULL;
+            const auto x = v ^ b;
+            return ~(((x & low7) + low7) | x | low7);
+        }
+    };
+
+#if defined(SSTRING8_SEARCH_X86)
+    /** 16 chars, which every x64 CPU has */
+    struct Sse2
+    {
+        static constexpr size_t width = 16;
+        static constexpr unsigned bitsPerChar = 1;
+        static constexpr uint64_t allMask = 0xFFFFU;
+        using Value = __m128i;
+        using Narrower = Word;
+        static Value load(const char* p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static Value broadcast(char ch) noexcept { return _mm_set1_epi8(ch); }
+        static uint64_t eq(Value v, Value b) noexcept { return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, b))); }
+    };
+#endif
+
+    /** The lanes from lane on (lane < Vec::width) */
+    template<class Vec>
+    uint64_t lanesFrom(size_t lane) noexcept
+    {
+        return Vec::allMask & (~uint64_t(0) << (lane * Vec::bitsPerChar));
+    }
+
+    /** The lanes before lane (lane < Vec::width) */
+    template<class Vec>
+    uint64_t lanesBefore(size_t lane) noexcept
+    {
+        return Vec::allMask & ((uint64_t(1) << (lane * Vec::bitsPerChar)) - 1U);
+    }
+
+    /**
+    The first position i in [0, count) whose lane is set in matcher.match<Vec>(block) and for which matcher.accept(i) is true.
+    match<Vec>(i) gives the lanes of positions i to i + width - 1, and must be able to read that far, so the last block overlaps the one before it.
+    Fewer than width positions go to the narrower Vec.
+    */
+    template<class Vec, class Matcher>
+    SSTRING8_SEARCH_INLINE size_t scanForward(size_t count, const Matcher& matcher) noexcept
+    {
+        if (count < Vec::width)
+        {
+            if constexpr (Vec::width == 1)
+                return kernelNpos;
+            else
+                return scanForward<typename Vec::Narrower>(count, matcher);
+        }
+        const auto check = [&matcher](size_t base, uint64_t mask)
+            {
+                for (; mask != 0; mask &= mask - 1U)
+                {
+                    const auto i = base + lowestBit(mask) / Vec::bitsPerChar;
+                    if (matcher.accept(i))
+                        return i;
+                }
+                return kernelNpos;
+            };
+        size_t i = 0;
+        for (; i + Vec::width <= count; i += Vec::width)
+        {
+            if (const auto found = check(i, matcher.template match<Vec>(i)); found != kernelNpos)
+                return found;
+        }
+        if (i == count)
+            return kernelNpos;
+        const auto base = count - Vec::width;
+        return check(base, matcher.template match<Vec>(base) & lanesFrom<Vec>(i - base));
+    }
+
+    /** As scanForward, for the last position */
+    template<class Vec, class Matcher>
+    SSTRING8_SEARCH_INLINE size_t scanBackward(size_t count, const Matcher& matcher) noexcept
+    {
+        if (count < Vec::width)
+        {
+            if constexpr (Vec::width == 1)
+                return kernelNpos;
+            else
+                return scanBackward<typename Vec::Narrower>(count, matcher);
+        }
+        const auto check = [&matcher](size_t base, uint64_t mask)
+            {
+                while (mask != 0)
+                {
+                    const auto bit = highestBit(mask);
+                    const auto i = base + bit / Vec::bitsPerChar;
+                    if (matcher.accept(i))
+                        return i;
+                    mask ^= uint64_t(1) << bit;
+                }
+                return kernelNpos;
+            };
+        auto end = count;
+        for (; end >= Vec::width; end -= Vec::width)
+        {
+            if (const auto found = check(end - Vec::width, matcher.template match<Vec>(end - Vec::width)); found != kernelNpos)
+                return found;
+        }
+        if (end == 0)
+            return kernelNpos;
+        return check(0, matcher.template match<Vec>(0) & lanesBefore<Vec>(end));
+    }
+
+    struct CharMatcher
+    {
+        const char* m_p;
+        char m_Ch;
+
+        template<class Vec>
+        uint64_t match(size_t i) const noexcept { return Vec::eq(Vec::load(m_p + i), Vec::broadcast(m_Ch)); }
+        bool accept(size_t) const noexcept { return true; }
+    };
+
+    /** Positions at which the needle's first and last chars both match, which are then compared in full */
+    struct SubstringMatcher
+    {
+        const char* m_p;
+        const char* m_pNeedle;
+        size_t m_NeedleLen;
+
+        template<class Vec>
+        uint64_t match(size_t i) const noexcept
+        {
+            return Vec::eq(Vec::load(m_p + i), Vec::broadcast(m_pNeedle[0]))
+                & Vec::eq(Vec::load(m_p + i + m_NeedleLen - 1U), Vec::broadcast(m_pNeedle[m_NeedleLen - 1U]));
+        }
+        bool accept(size_t i) const noexcept { return m_NeedleLen <= 2U || 0 == memcmp(m_p + i + 1U, m_pNeedle + 1U, m_NeedleLen - 2U); }
+    };
+
+    /** Up to maxVecSetSize chars, each compared with a whole block */
+    struct SetMatcher
+    {
+        const char* m_p;
+        const char* m_pSet;
+        size_t m_SetLen;
+        bool m_NotOf;
+
+        template<class Vec>
+        uint64_t match(size_t i) const noexcept
+        {
+            const auto v = Vec::load(m_p + i);
+            uint64_t mask = 0;
+            for (size_t j = 0; j < m_SetLen; ++j)
+                mask |= Vec::eq(v, Vec::broadcast(m_pSet[j]));
+            return m_NotOf ? (mask ^ Vec::allMask) : mask;
+        }
+        bool accept(size_t) const noexcept { return true; }
+    };
+
+    /** Any number of chars, looked up a char at a time in a table with a bit per char value */
+    struct TableMatcher
+    {
+        const char* m_p;
+        uint64_t m_Table[4] = {};
+        bool m_NotOf;
+
+        TableMatcher(const char* p, const char* pSet, size_t setLen, bool notOf) noexcept
+            : m_p(p)
+            , m_NotOf(notOf)
+        {
+            // built in registers, as or-ing into m_Table[ch >> 6] would make each char wait for the store of the one before
+            uint64_t table0 = 0, table1 = 0, table2 = 0, table3 = 0;
+            for (size_t j = 0; j < setLen; ++j)
+            {
+                const auto ch = static_cast<uint8_t>(pSet[j]);
+                const auto bit = uint64_t(1) << (ch & 63U);
+                table0 |= (ch < 64U) ? bit : 0U;
+                table1 |= (ch >= 64U && ch < 128U) ? bit : 0U;
+                table2 |= (ch >= 128U && ch < 192U) ? bit : 0U;
+                table3 |= (ch >= 192U) ? bit : 0U;
+            }
+            m_Table[0] = table0;
+            m_Table[1] = table1;
+            m_Table[2] = table2;
+            m_Table[3] = table3;
+        }
+
+        template<class Vec>
+        uint64_t match(size_t i) const noexcept
+        {
+            static_assert(Vec::width == 1);
+            const auto ch = static_cast<uint8_t>(m_p[i]);
+            return ((m_Table[ch >> 6U] >> (ch & 63U)) & 1U) != static_cast<uint64_t>(m_NotOf);
+        }
+        bool accept(size_t) const noexcept { return true; }
+    };
+
+    /** Every position that Matcher matches, each recorded by accept, which only stops the scan once there is no room for more */
+    template<class Matcher>
+    struct Collecting
+    {
+        Matcher m_Matcher;
+        size_t* m_pPositions;
+        size_t m_MaxPositions;
+        size_t* m_pCount;
+
+        template<class Vec>
+        uint64_t match(size_t i) const noexcept { return m_Matcher.template match<Vec>(i); }
+        bool accept(size_t i) const noexcept
+        {
+            m_pPositions[*m_pCount] = i;
+            return ++*m_pCount == m_MaxPositions;
+        }
+    };
+
+    template<class Vec>
+    size_t rfindCharKernel(const char* p, size_t len, char ch) noexcept
+    {
+        return scanBackward<Vec>(len, CharMatcher{ p, ch });
+    }
+
+    template<class Vec>
+    size_t findKernel(const char* p, size_t len, const char* pNeedle, size_t needleLen) noexcept
+    {
+        // only for needles longer than maxShortNeedle, but right for any length, as the matcher compares nothing more when the first char is the last
+        if (needleLen > len)
+            return kernelNpos;
+        return scanForward<Vec>(len - needleLen + 1U, SubstringMatcher{ p, pNeedle, needleLen });
+    }
+
+    template<class Vec>
+    size_t rfindKernel(const char* p, size_t len, const char* pNeedle, size_t needleLen) noexcept
+    {
+        if (needleLen > len)
+            return kernelNpos;
+        if (needleLen == 1)
+            return rfindCharKernel<Vec>(p, len, pNeedle[0]);
+        return scanBackward<Vec>(len - needleLen + 1U, SubstringMatcher{ p, pNeedle, needleLen });
+    }
+
+    template<class Vec>
+    size_t findOfKernel(const char* p, size_t len, const char* pSet, size_t setLen, bool notOf) noexcept
+    {
+        if (setLen > maxVecSetSize)
+            return scanForward<Bytes>(len, TableMatcher(p, pSet, setLen, notOf));
+        return scanForward<Vec>(len, SetMatcher{ p, pSet, setLen, notOf });
+    }
+
+    template<class Vec>
+    size_t rfindOfKernel(const char* p, size_t len, const char* pSet, size_t setLen, bool notOf) noexcept
+    {
+        if (setLen > maxVecSetSize)
+            return scanBackward<Bytes>(len, TableMatcher(p, pSet, setLen, notOf));
+        return scanBackward<Vec>(len, SetMatcher{ p, pSet, setLen, notOf });
+    }
+
+    template<class Vec>
+    size_t findAllCharKernel(const char* p, size_t len, char ch, size_t* pPositions, size_t maxPositions) noexcept
+    {
+        size_t count = 0;
+        if (maxPositions != 0)
+            scanForward<Vec>(len, Collecting<CharMatcher>{ CharMatcher{ p, ch }, pPositions, maxPositions, &count });
+        return count;
+    }
+
+    template<class Vec>
+    size_t findAllOfKernel(const char* p, size_t len, const char* pSet, size_t setLen, size_t* pPositions, size_t maxPositions) noexcept
+    {
+        size_t count = 0;
+        if (maxPositions == 0)
+            return 0;
+        if (setLen > maxVecSetSize)
+            scanForward<Bytes>(len, Collecting<TableMatcher>{ TableMatcher(p, pSet, setLen, false), pPositions, maxPositions, &count });
+        else
+            scanForward<Vec>(len, Collecting<SetMatcher>{ SetMatcher{ p, pSet, setLen, false }, pPositions, maxPositions, &count });
+        return count;
+    }
+
+    template<class Vec>
+    constexpr Kernels kernelsFor() noexcept
+    {
+        return { &rfindCharKernel<Vec>, &findKernel<Vec>, &rfindKernel<Vec>, &findOfKernel<Vec>, &rfindOfKernel<Vec>, &findAllCharKernel<Vec>, &findAllOfKernel<Vec> };
+    }
+}
@@ -0,0 +1,106 @@
+#include "SString8Slab.h"
+
+#include <mutex>
+#include <new>
+
+namespace
+{
+    using namespace SString8Detail::Slab;
+
+    std::mutex g_AbandonedMutex;
+    Heap* g_pAbandoned = nullptr;
+
+    /** Heaps of exited threads are kept for new threads, rather than freed, as other threads may still hold blocks from them */
+    Heap* adoptHeap()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(g_AbandonedMutex);
+            if (auto pHeap = g_pAbandoned)
+            {
+                g_pAbandoned = pHeap->m_pNextAbandoned;
+                pHeap->m_pNextAbandoned = nullptr;
+                return pHeap;
+            }
+        }
+        return new Heap;
+    }
+
+    void abandonHeap(Heap* pHeap) noexcept
+    {
+        const std::lock_guard<std::mutex> lock(g_AbandonedMutex);
+        pHeap->m_pNextAbandoned = g_pAbandoned;
+        g_pAbandoned = pHeap;
+    }
+
+    /** Owns this thread's heap, and hands it back when the thread exits */
+    struct ThreadHeap
+    {
+        Heap* m_pHeap = nullptr;
+
+        Heap* get()
+        {
+            if (!m_pHeap)
+            {
+                m_pHeap = adoptHeap();
+                t_pHeap = m_pHeap;
+            }
+            return m_pHeap;
+        }
+
+        ~ThreadHeap()
+        {
+            if (m_pHeap)
+            {
+                t_pHeap = nullptr;
+                abandonHeap(m_pHeap);
+                m_pHeap = nullptr;
+            }
+        }
+    };
+    thread_local ThreadHeap t_ThreadHeap;
+}
+
+void* SString8Detail::Slab::allocateSlow(size_t sizeClass)
+{
+    auto pHeap = t_pHeap;
+    if (!pHeap)
+    {
+        // the first allocation on this thread (or one made after its heap was handed back on exit, which gets a heap that is never handed back)
+        pHeap = t_ThreadHeap.get();
+    }
+    if (auto pBlock = pHeap->m_pFree[sizeClass])
+    {
+        pHeap->m_pFree[sizeClass] = pBlock->m_pNext;
+        return pBlock;
+    }
+    // blocks freed by other threads
+    if (auto pBlock = pHeap->m_RemoteFree[sizeClass].exchange(nullptr, std::memory_order_acquire))
+    {
+        pHeap->m_pFree[sizeClass] = pBlock->m_pNext;
+        return pBlock;
+    }
+    const auto blockSize = (sizeClass + 1) * granularity;
+    auto& pBump = pHeap->m_pBump[sizeClass];
+    if (pBump == pHeap->m_pBumpEnd[sizeClass])
+    {
+        auto pChunk = static_cast<char*>(::operator new(chunkSize, std::align_val_t(chunkSize)));
+        new (pChunk) ChunkHeader{ pHeap };
+        pBump = pChunk + chunkHeaderSize;
+        pHeap->m_pBumpEnd[sizeClass] = pBump + ((chunkSize - chunkHeaderSize) / blockSize) * blockSize;
+    }
+    auto p = pBump;
+    pBump += blockSize;
+    return p;
+}
+
+void SString8Detail::Slab::freeRemote(void* p, size_t sizeClass) noexcept
+{
+    const auto pChunk = reinterpret_cast<const ChunkHeader*>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t(chunkSize) - 1U));
+    auto& head = pChunk->m_pOwner->m_RemoteFree[sizeClass];
+    auto pBlock = static_cast<FreeBlock*>(p);
+    auto pOld = head.load(std::memory_order_relaxed);
+    do
+    {
+        pBlock->m_pNext = pOld;
+    } while (!head.compare_exchange_weak(pOld, pBlock, std::memory_order_release, std::memory_order_relaxed));
+}
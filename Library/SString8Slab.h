@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace SString8Detail
+{
+    /**
+    Size class allocator for the small SString8 tier (allocations of up to 256 bytes).
+    Blocks come in 16 size classes, 16 bytes apart, and are carved out of 64KB chunks.  Each chunk belongs to one thread's heap and holds one size class.
+    Each thread allocates from, and frees its own blocks to, free lists of its own heap, with no locking or atomics.
+    A block freed by another thread is pushed on to an atomic list in the owning heap, which the owner takes back when its own list runs dry.
+    When a thread exits its heap is kept for the next new thread to adopt, so blocks that are still in use elsewhere remain valid.
+    Memory is never given back to the system.
+    */
+    namespace Slab
+    {
+        static inline constexpr size_t granularity = 16;
+        static inline constexpr size_t maxBlockSize = 256;
+        static inline constexpr size_t classCount = maxBlockSize / granularity;
+        static inline constexpr size_t chunkSize = 64 * 1024;
+        static inline constexpr size_t chunkHeaderSize = 64;
+
+        struct FreeBlock
+        {
+            FreeBlock* m_pNext;
+        };
+
+        static inline constexpr size_t cacheLineSize = 64;
+
+        /** The owner's lists, and then on cache lines of their own the lists that other threads push to, so that a free from another thread doesn't take the owner's lines away from it */
+        struct alignas(cacheLineSize) Heap
+        {
+            FreeBlock* m_pFree[classCount] = {};
+            char* m_pBump[classCount] = {};
+            char* m_pBumpEnd[classCount] = {};
+            Heap* m_pNextAbandoned = nullptr;
+            alignas(cacheLineSize) std::atomic<FreeBlock*> m_RemoteFree[classCount] = {};
+        };
+        static_assert(offsetof(Heap, m_RemoteFree) % cacheLineSize == 0 && sizeof(Heap) % cacheLineSize == 0);
+
+        /** At the start of every chunk, so a block can find its heap by rounding its address down to the chunk size */
+        struct ChunkHeader
+        {
+            Heap* m_pOwner;
+        };
+        static_assert(sizeof(ChunkHeader) <= chunkHeaderSize);
+
+        /** This thread's heap, or null before its first allocation (and after it has exited) */
+        inline thread_local Heap* t_pHeap = nullptr;
+
+        inline size_t sizeClass(size_t bytes) noexcept
+        {
+            return (bytes - 1) / granularity;
+        }
+
+        void* allocateSlow(size_t sizeClass);
+        void freeRemote(void* p, size_t sizeClass) noexcept;
+
+        /** bytes must be from 1 to maxBlockSize.  The result is 16 byte aligned */
+        inline void* allocate(size_t bytes)
+        {
+            const auto cls = sizeClass(bytes);
+            if (auto pHeap = t_pHeap)
+            {
+                if (auto pBlock = pHeap->m_pFree[cls])
+                {
+                    pHeap->m_pFree[cls] = pBlock->m_pNext;
+                    return pBlock;
+                }
+            }
+            return allocateSlow(cls);
+        }
+
+        /** bytes must be the size that p was allocated with */
+        inline void free(void* p, size_t bytes) noexcept
+        {
+            const auto cls = sizeClass(bytes);
+            const auto pChunk = reinterpret_cast<const ChunkHeader*>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t(chunkSize) - 1U));
+            if (auto pHeap = t_pHeap; pHeap && pChunk->m_pOwner == pHeap)
+            {
+                auto pBlock = static_cast<FreeBlock*>(p);
+                pBlock->m_pNext = pHeap->m_pFree[cls];
+                pHeap->m_pFree[cls] = pBlock;
+                return;
+            }
+            freeRemote(p, cls);
+        }
+    }
+}
+
+/**
+Stateless allocator using the SString8Detail::Slab size classes for allocations of up to 256 bytes (the small tier), and the global operator new for anything bigger.
+Used by SlabSString8, and by SString8 itself when SSTRING8_SLAB_ALLOCATOR is defined.
+*/
+template<class T>
+struct SString8SlabAllocator
+{
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    SString8SlabAllocator() noexcept = default;
+    template<class U>
+    SString8SlabAllocator(const SString8SlabAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        const auto bytes = n * sizeof(T);
+        if (isSlabSize(bytes))
+            return static_cast<T*>(SString8Detail::Slab::allocate(bytes));
+        return static_cast<T*>(::operator new(bytes));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        const auto bytes = n * sizeof(T);
+        if (isSlabSize(bytes))
+            SString8Detail::Slab::free(p, bytes);
+        else
+            ::operator delete(p);
+    }
+
+    friend bool operator==(const SString8SlabAllocator&, const SString8SlabAllocator&) noexcept { return true; }
+
+private:
+    static bool isSlabSize(size_t bytes) noexcept
+    {
+        // 1 to maxBlockSize (0 wraps around to a huge number)
+        return bytes - 1U < SString8Detail::Slab::maxBlockSize && alignof(T) <= SString8Detail::Slab::granularity;
+    }
+};
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "SString8.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace SString8Detail
+{
+    /**
+    Sorts SString8s by radix sorting their 8 byte prefix keys (see basic_SString8Data::prefixKey), then comparing strings in full only within runs of equal keys.
+
+    The key and the word of each string are copied to a scratch array, which is sorted with a least significant byte first radix sort, a pass per key byte.
+    Passes over a byte that is the same in every key (eg the 8th byte when every string is 7 chars or fewer) are skipped.
+    The words are then written back, in order, so the strings are moved without their constructors (a word is the whole of a string, so this is safe).
+    A buffer string's key comes from its word alone, so strings of 7 chars or fewer are sorted without reading any other memory.
+
+    The radix sort is stable, so with a stable sort of the runs of equal keys the whole sort is stable.
+    With more than one thread each pass is split into slices, one per thread, which count and then scatter their own slice.
+    */
+    template<class Alloc>
+    class RadixSorter
+    {
+    public:
+        using String = basic_SString8<Alloc>;
+
+        static void sort(String* pFirst, size_t count, bool stable, size_t threadCount)
+        {
+            if (count < 2)
+                return;
+            if (count <= smallSortSize)
+            {
+                // too few strings for the histograms and scratch array to pay for themselves: a comparison sort of the keys, on the stack
+                Item items[smallSortSize];
+                for (size_t i = 0; i != count; ++i)
+                {
+                    const auto& data = SString8Access::storage(pFirst[i]);
+                    items[i] = Item{ data.prefixKey(), data.m_Storage.m_pLargeStr };
+                }
+                const auto byKey = [](const Item& lhs, const Item& rhs) { return lhs.m_Key < rhs.m_Key; };
+                if (stable)
+                    std::stable_sort(items, items + count, byKey);
+                else
+                    std::sort(items, items + count, byKey);
+                writeBack(pFirst, items, 0, count, stable);
+                return;
+            }
+            // allocated before anything is moved, so if this throws the strings are unchanged
+            std::vector<Item> items(count);
+            std::vector<Item> scratch(count);
+            if (count < minSliceSize * 2)
+                threadCount = 1;
+            threadCount = std::min(threadCount, count / minSliceSize + 1);
+
+            // the keys, and a count of each byte value at each byte position
+            std::vector<Counts> histograms(threadCount * keyBytes);
+            forEachSlice(threadCount, count, [&](size_t thread, size_t begin, size_t end)
+                {
+                    auto pHistogram = &histograms[thread * keyBytes];
+                    for (auto i = begin; i != end; ++i)
+                    {
+                        const auto& data = SString8Access::storage(pFirst[i]);
+                        const auto key = data.prefixKey();
+                        items[i] = Item{ key, data.m_Storage.m_pLargeStr };
+                        for (size_t byte = 0; byte != keyBytes; ++byte)
+                            ++pHistogram[byte][(key >> (8U * byte)) & 0xFFU];
+                    }
+                });
+
+            auto pSrc = &items;
+            auto pDst = &scratch;
+            for (size_t byte = 0; byte != keyBytes; ++byte)
+            {
+                if (allInOneBucket(histograms, threadCount, byte, count))
+                    continue;
+                radixPass(*pSrc, *pDst, histograms, threadCount, byte);
+                std::swap(pSrc, pDst);
+            }
+
+            // write the words back, and sort each run of equal keys in full.  A slice starts and ends at the start of a run, so no run is split between threads
+            const auto& sorted = *pSrc;
+            forEachSlice(threadCount, count, [&](size_t, size_t begin, size_t end)
+                {
+                    writeBack(pFirst, sorted.data(), runStart(sorted, begin), runStart(sorted, end), stable);
+                });
+        }
+
+    private:
+        static inline constexpr size_t keyBytes = 8;
+        // below this many strings per thread, threads cost more than they save
+        static inline constexpr size_t minSliceSize = 32 * 1024;
+        // up to this many strings, a comparison sort of the keys is quicker than setting up the radix passes
+        static inline constexpr size_t smallSortSize = 64;
+
+        struct Item
+        {
+            uint64_t m_Key;
+            uint64_t m_Word;
+        };
+        using Counts = size_t[256];
+
+        /** Call fn(thread, begin, end) for threadCount slices of [0, count), on threads of their own apart from the first, which runs on this thread */
+        template<class Fn>
+        static void forEachSlice(size_t threadCount, size_t count, Fn&& fn) noexcept
+        {
+            const auto sliceBegin = [threadCount, count](size_t thread) { return count / threadCount * thread + std::min(thread, count % threadCount); };
+            std::vector<std::thread> threads;
+            for (size_t thread = 1; thread < threadCount; ++thread)
+            {
+                try
+                {
+                    threads.emplace_back([&fn, &sliceBegin, thread]() { fn(thread, sliceBegin(thread), sliceBegin(thread + 1)); });
+                }
+                catch (...)
+                {
+                    // no thread (or no memory for one): this thread does the slice, as once words start moving every slice has to be done
+                    fn(thread, sliceBegin(thread), sliceBegin(thread + 1));
+                }
+            }
+            fn(0, sliceBegin(0), sliceBegin(1));
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        static bool allInOneBucket(const std::vector<Counts>& histograms, size_t threadCount, size_t byte, size_t count) noexcept
+        {
+            for (size_t value = 0; value != 256; ++value)
+            {
+                size_t total = 0;
+                for (size_t thread = 0; thread != threadCount; ++thread)
+                    total += histograms[thread * keyBytes + byte][value];
+                if (total != 0)
+                    return total == count;
+            }
+            return false;
+        }
+
+        static void radixPass(const std::vector<Item>& src, std::vector<Item>& dst, std::vector<Counts>& histograms, size_t threadCount, size_t byte)
+        {
+            const auto shift = 8U * byte;
+            // the slices of src are not the ones that the histograms were counted from (after the first pass), so each thread counts its own slice again
+            std::vector<Counts> counts(threadCount);
+            if (threadCount == 1)
+            {
+                std::copy(std::begin(histograms[byte]), std::end(histograms[byte]), counts[0]);
+            }
+            else
+            {
+                forEachSlice(threadCount, src.size(), [&](size_t thread, size_t begin, size_t end)
+                    {
+                        auto& threadCounts = counts[thread];
+                        std::fill(std::begin(threadCounts), std::end(threadCounts), size_t(0));
+                        for (auto i = begin; i != end; ++i)
+                            ++threadCounts[(src[i].m_Key >> shift) & 0xFFU];
+                    });
+            }
+            // each thread's counts become where its first item of each value goes: after every lower value, and after the same value in earlier slices
+            size_t offset = 0;
+            for (size_t value = 0; value != 256; ++value)
+            {
+                for (size_t thread = 0; thread != threadCount; ++thread)
+                {
+                    const auto n = counts[thread][value];
+                    counts[thread][value] = offset;
+                    offset += n;
+                }
+            }
+            forEachSlice(threadCount, src.size(), [&](size_t thread, size_t begin, size_t end)
+                {
+                    auto& next = counts[thread];
+                    for (auto i = begin; i != end; ++i)
+                        dst[next[(src[i].m_Key >> shift) & 0xFFU]++] = src[i];
+                });
+        }
+
+        /** Write the words of sorted[begin, end) back to pFirst[begin, end), in order, and sort each run of equal keys in full */
+        static void writeBack(String* pFirst, const Item* sorted, size_t begin, size_t end, bool stable)
+        {
+            for (auto i = begin; i != end; ++i)
+                SString8Access::storage(pFirst[i]).m_Storage.m_pLargeStr = sorted[i].m_Word;
+            for (auto i = begin; i != end;)
+            {
+                auto runEnd = i + 1;
+                while (runEnd != end && sorted[runEnd].m_Key == sorted[i].m_Key)
+                    ++runEnd;
+                if (runEnd - i > 1)
+                {
+                    if (stable)
+                        std::stable_sort(pFirst + i, pFirst + runEnd);
+                    else
+                        std::sort(pFirst + i, pFirst + runEnd);
+                }
+                i = runEnd;
+            }
+        }
+
+        /** The start of the run of equal keys that pos is in (or pos itself, at the end) */
+        static size_t runStart(const std::vector<Item>& sorted, size_t pos) noexcept
+        {
+            if (pos == sorted.size())
+                return pos;
+            while (pos != 0 && sorted[pos - 1].m_Key == sorted[pos].m_Key)
+                --pos;
+            return pos;
+        }
+    };
+
+    template<class It>
+    concept SString8Iterator = std::contiguous_iterator<It> && isSString8<std::iter_value_t<It>> && !std::is_const_v<std::remove_reference_t<std::iter_reference_t<It>>>;
+
+    template<class Alloc>
+    void radixSort(basic_SString8<Alloc>* pFirst, size_t count, bool stable, size_t threadCount)
+    {
+        RadixSorter<Alloc>::sort(pFirst, count, stable, threadCount);
+    }
+}
+
+/**
+Sort SString8s into the same order as std::sort would (by operator<), usually much faster: see SString8Detail::RadixSorter.
+Needs scratch space of 32 bytes per string.  first and last must be contiguous iterators (eg into a vector or array)
+*/
+template<SString8Detail::SString8Iterator It>
+void sort_sstring8(It first, It last) // test - SString8SortTest
+{
+    SString8Detail::radixSort(std::to_address(first), static_cast<size_t>(last - first), false, 1);
+}
+
+/** As sort_sstring8, keeping equal strings in their original order, as std::stable_sort does */
+template<SString8Detail::SString8Iterator It>
+void stable_sort_sstring8(It first, It last) // test - SString8SortTest
+{
+    SString8Detail::radixSort(std::to_address(first), static_cast<size_t>(last - first), true, 1);
+}
+
+/**
+As stable_sort_sstring8, on threadCount threads (by default one per hardware thread).
+Fewer threads are used for smaller inputs, with at least 32K strings per thread, so below 64K strings this is the same as stable_sort_sstring8.
+*/
+template<SString8Detail::SString8Iterator It>
+void parallel_sort_sstring8(It first, It last, size_t threadCount = 0) // test - SString8SortTestParallel
+{
+    if (threadCount == 0)
+        threadCount = std::max(1U, std::thread::hardware_concurrency());
+    SString8Detail::radixSort(std::to_address(first), static_cast<size_t>(last - first), true, threadCount);
+}
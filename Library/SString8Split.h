@@ -0,0 +1,78 @@
+#pragma once
+
+#include "SString8.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace SString8Detail
+{
+    /**
+    Calls field(index, chars) for each field of record, in order, where the fields are separated by delimiter (so there is always one more field than delimiters).
+    The delimiters are found a batch at a time with Search::findAllChar, so a record of short fields is scanned a block at a time rather than a call per field.
+    */
+    template<class Field>
+    size_t forEachField(std::string_view record, char delimiter, Field&& field)
+    {
+        constexpr size_t batchSize = 64;
+        size_t positions[batchSize];
+        const auto p = record.data();
+        size_t fieldCount = 0;
+        size_t start = 0;
+        for (auto scanFrom = start;;)
+        {
+            const auto found = Search::findAllChar(p + scanFrom, record.size() - scanFrom, delimiter, positions, batchSize);
+            for (size_t i = 0; i < found; ++i)
+            {
+                const auto end = scanFrom + positions[i];
+                field(fieldCount++, std::string_view(p + start, end - start));
+                start = end + 1U;
+            }
+            if (found < batchSize)
+                break;
+            scanFrom = start;
+        }
+        field(fieldCount++, std::string_view(p + start, record.size() - start));
+        return fieldCount;
+    }
+}
+
+/**
+Split record at each delimiter (eg a line of CSV or TSV, without its line ending) into fields, which is resized to the number of fields.
+No quoting or escaping is done, and an empty record is one empty field.
+
+The strings already in fields are assigned to, which keeps their heap allocations, so splitting record after record into the same vector settles down to no allocation at all.
+Fields of 7 chars or fewer go in the buffer of a new string, and into the existing chars of a reused one.
+Strings past the new size are destroyed (as by resize).
+Gives the number of fields
+*/
+template<class Alloc>
+size_t split_sstring8(std::string_view record, char delimiter, std::vector<basic_SString8<Alloc>>& fields) // test - SString8SplitTestVector
+{
+    const auto oldSize = fields.size();
+    const auto count = SString8Detail::forEachField(record, delimiter, [&fields, oldSize](size_t i, std::string_view field)
+        {
+            if (i < oldSize)
+                fields[i].assign(field);
+            else
+                fields.emplace_back(field);
+        });
+    if (count < oldSize)
+        fields.resize(count);
+    return count;
+}
+
+/**
+As the vector overload, into the maxFields strings at pFields, which must already exist.
+Gives the number of fields in record, which may be more than maxFields, in which case only the first maxFields are written
+*/
+template<class Alloc>
+size_t split_sstring8(std::string_view record, char delimiter, basic_SString8<Alloc>* pFields, size_t maxFields) // test - SString8SplitTestArray
+{
+    return SString8Detail::forEachField(record, delimiter, [pFields, maxFields](size_t i, std::string_view field)
+        {
+            if (i < maxFields)
+                pFields[i].assign(field);
+        });
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "SString8.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace SString8Detail
+{
+    /** Multiply-shift hash of a buffer word down to m_Bits bits */
+    struct SwitchHash
+    {
+        uint64_t m_Multiplier = 0;
+        unsigned m_Bits = 0;
+
+        constexpr size_t operator()(uint64_t word) const noexcept
+        {
+            return static_cast<size_t>((word * m_Multiplier) >> (64U - m_Bits));
+        }
+    };
+
+    /** A slot of the switch's hash table.  An empty slot has a word with the top bit set, which no buffer string has */
+    struct SwitchSlot
+    {
+        uint64_t m_Word = ~0ULL;
+        size_t m_Index = static_cast<size_t>(-1);
+    };
+
+    // The compile time parts of SString8Switch, as free functions so that they can be used while the class is still incomplete
+
+    template<size_t N>
+    consteval bool switchKeysDifferent(const std::array<std::string_view, N>& keys)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = i + 1; j < N; ++j)
+            {
+                if (keys[i] == keys[j])
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    template<size_t N>
+    consteval size_t switchShortCount(const std::array<std::string_view, N>& keys)
+    {
+        size_t count = 0;
+        for (const auto key : keys)
+            count += (key.size() <= 7) ? 1U : 0U;
+        return count;
+    }
+
+    /** Indices into keys of the keys that are 7 chars or fewer (Short), or of the rest */
+    template<bool Short, size_t Count, size_t N>
+    consteval std::array<size_t, Count> switchIndices(const std::array<std::string_view, N>& keys)
+    {
+        std::array<size_t, Count> indices = {};
+        size_t count = 0;
+        for (size_t i = 0; i < N; ++i)
+        {
+            if ((keys[i].size() <= 7) == Short)
+                indices[count++] = i;
+        }
+        return indices;
+    }
+
+    /** The buffer words of the keys at these indices */
+    template<size_t Count, size_t N>
+    consteval std::array<uint64_t, Count> switchWords(const std::array<std::string_view, N>& keys, const std::array<size_t, Count>& indices)
+    {
+        std::array<uint64_t, Count> words = {};
+        for (size_t i = 0; i < Count; ++i)
+            words[i] = SString8Data::constantBufferWord(keys[indices[i]].data(), keys[indices[i]].size());
+        return words;
+    }
+
+    /**
+    Find a multiplier that sends each word to a different slot of a table of 2^bits slots, trying the smallest table first.
+    Candidate multipliers come from splitmix64, so the search is the same on every compiler.
+    */
+    template<size_t Count>
+    consteval SwitchHash switchPerfectHash(const std::array<uint64_t, Count>& words)
+    {
+        constexpr unsigned maxExtraBits = 4;
+        constexpr size_t triesPerSize = 4096;
+        const auto minBits = static_cast<unsigned>(std::bit_width(Count < 2 ? size_t(1) : Count - 1));
+        uint64_t seed = 0;
+        for (auto bits = minBits; bits <= minBits + maxExtraBits; ++bits)
+        {
+            auto used = new bool[size_t(1) << bits];
+            for (size_t attempt = 0; attempt < triesPerSize; ++attempt)
+            {
+                seed += 0x9e3779b97f4a7c15ULL;
+                auto z = seed;
+                z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+                const SwitchHash hash{ (z ^ (z >> 31U)) | 1U, bits };
+                for (size_t slot = 0; slot < (size_t(1) << bits); ++slot)
+                    used[slot] = false;
+                bool perfect = true;
+                for (size_t i = 0; i < Count && perfect; ++i)
+                {
+                    const auto slot = hash(words[i]);
+                    perfect = !used[slot];
+                    used[slot] = true;
+                }
+                if (perfect)
+                {
+                    delete[] used;
+                    return hash;
+                }
+            }
+            delete[] used;
+        }
+        throw std::logic_error("no perfect hash found for the SString8Switch keys");
+    }
+
+    template<size_t TableSize, size_t Count>
+    consteval std::array<SwitchSlot, TableSize> switchTable(const SwitchHash& hash, const std::array<uint64_t, Count>& words, const std::array<size_t, Count>& indices)
+    {
+        std::array<SwitchSlot, TableSize> table = {};
+        for (size_t i = 0; i < Count; ++i)
+            table[hash(words[i])] = SwitchSlot{ words[i], indices[i] };
+        return table;
+    }
+} // namespace SString8Detail
+
+/**
+Maps a string to the index of the matching key, for dispatching on a fixed set of keywords (eg protocol tokens) with a switch:
+
+    using Methods = SString8Switch<"GET", "PUT", "POST">;
+    switch (Methods::find(token))
+    {
+    case Methods::indexOf("GET"): ...
+    case Methods::npos: ...
+    }
+
+Keys of 7 chars or fewer are found with a perfect hash over the buffer word, built at compile time: one multiply and shift, and one 64 bit compare.
+Longer keys, which can only match heap strings, are compared one by one after a length check.
+A heap string of 7 chars or fewer is turned into the word that a buffer string would have, so it matches too.
+*/
+template<SString8Detail::BufferLiteral... Keys>
+class SString8Switch
+{
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static constexpr size_t size = sizeof...(Keys);
+
+    /** The index of key in Keys.  Fails to compile if it isn't one of them */
+    static consteval size_t indexOf(std::string_view key)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (keys[i] == key)
+                return i;
+        }
+        throw std::logic_error("not an SString8Switch key");
+    }
+
+    /** The index of the key equal to str, or npos */
+    template<class Alloc>
+    static constexpr size_t find(const basic_SString8<Alloc>& str) noexcept // test - SString8SwitchTestFind
+    {
+        const auto& data = SString8Detail::SString8Access::storage(str);
+        const auto word = data.m_Storage.m_pLargeStr;
+        if ((word & Data::top) == 0)
+            return findWord(word);
+        const auto [pData, len] = data.getDataAndSize();
+        return find(std::string_view(pData, len));
+    }
+
+    /** The index of the key equal to str, or npos */
+    static constexpr size_t find(std::string_view str) noexcept // test - SString8SwitchTestFind
+    {
+        if (str.size() <= 7)
+        {
+            if (std::is_constant_evaluated())
+                return findWord(Data::constantBufferWord(str.data(), str.size()));
+            return findWord(Data::makeBufferWord(str.data(), str.size()));
+        }
+        for (size_t i = 0; i < longCount; ++i)
+        {
+            if (keys[longIndices[i]] == str)
+                return longIndices[i];
+        }
+        return npos;
+    }
+
+private:
+    using Data = SString8Detail::SString8Data;
+
+    static constexpr std::array<std::string_view, size> keys = { std::string_view(Keys.m_Chars, Keys.size)... };
+    static_assert(SString8Detail::switchKeysDifferent(keys), "SString8Switch keys must all be different");
+
+    static constexpr size_t shortCount = SString8Detail::switchShortCount(keys);
+    static constexpr size_t longCount = size - shortCount;
+    static constexpr auto shortIndices = SString8Detail::switchIndices<true, shortCount>(keys);
+    static constexpr auto longIndices = SString8Detail::switchIndices<false, longCount>(keys);
+    static constexpr auto shortWords = SString8Detail::switchWords(keys, shortIndices);
+    static constexpr SString8Detail::SwitchHash hash = SString8Detail::switchPerfectHash(shortWords);
+    static constexpr auto table = SString8Detail::switchTable<size_t(1) << hash.m_Bits>(hash, shortWords, shortIndices);
+
+    static constexpr size_t findWord(uint64_t word) noexcept
+    {
+        const auto& slot = table[hash(word)];
+        return (slot.m_Word == word) ? slot.m_Index : npos;
+    }
+};
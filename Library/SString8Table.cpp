@@ -0,0 +1,47 @@
+#include "SString8Table.h"
+
+#include <string>
+#include <utility>
+
+SString8TableView::SString8TableView(const std::filesystem::path& path)
+    : m_File(path, SString8Detail::MappedFile::Access::READ_ONLY, "SString8TableView")
+{
+    using namespace SString8TableFormat;
+    const auto fileSize = m_File.size();
+    if (fileSize < sizeof(Header))
+        throw std::runtime_error("SString8TableView - not a string table: " + path.string());
+    Header header;
+    memcpy(&header, m_File.data(), sizeof(header));
+    // the entries must fit between the header and the blob, and the blob must fit in the file
+    const auto maxCount = (fileSize - sizeof(Header)) / sizeof(uint64_t);
+    if (memcmp(header.m_Magic, magic, sizeof(magic)) != 0
+        || header.m_Count > maxCount
+        || header.m_BlobOffset != sizeof(Header) + header.m_Count * sizeof(uint64_t)
+        || header.m_BlobSize > fileSize - header.m_BlobOffset)
+    {
+        throw std::runtime_error("SString8TableView - not a string table: " + path.string());
+    }
+    m_Count = static_cast<size_t>(header.m_Count);
+    m_pBlob = m_File.data() + header.m_BlobOffset;
+    m_BlobSize = static_cast<size_t>(header.m_BlobSize);
+}
+
+SString8TableView::SString8TableView(SString8TableView&& rhs) noexcept
+    : m_File(std::move(rhs.m_File))
+    , m_Count(std::exchange(rhs.m_Count, 0))
+    , m_pBlob(std::exchange(rhs.m_pBlob, nullptr))
+    , m_BlobSize(std::exchange(rhs.m_BlobSize, 0))
+{
+}
+
+SString8TableView& SString8TableView::operator=(SString8TableView&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        m_File = std::move(rhs.m_File);
+        m_Count = std::exchange(rhs.m_Count, 0);
+        m_pBlob = std::exchange(rhs.m_pBlob, nullptr);
+        m_BlobSize = std::exchange(rhs.m_BlobSize, 0);
+    }
+    return *this;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "SString8.h"
+#include "SString8MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+
+/**
+A file format for a sequence of strings that can be memory mapped and read in place, so loading a table costs the pages that are read, rather than a copy of every string.
+
+    Header (32 bytes): magic "SS8TBL" followed by the version (1) and a 0, the entry count, the file offset of the blob section, and its size in bytes
+    Entries (8 bytes each, starting at byte 32):
+        A string of 7 chars or fewer is its SString8 buffer word, as it is held in memory (top bit 0)
+        A longer string is the top bit set, and below it the offset in the blob of the string's record
+    Blob: a record per longer string, an 8 byte length followed by the chars and a null terminator (so that they can be borrowed by an SString8)
+
+All numbers are little endian, as SString8 is.  Written by writeSString8Table and read by SString8TableView.
+*/
+namespace SString8TableFormat
+{
+    static inline constexpr char magic[8] = { 'S', 'S', '8', 'T', 'B', 'L', '1', '\0' };
+
+    struct Header
+    {
+        char m_Magic[8];
+        uint64_t m_Count;
+        uint64_t m_BlobOffset;
+        uint64_t m_BlobSize;
+    };
+    static_assert(sizeof(Header) == 32);
+
+    static inline constexpr uint64_t blobEntryBit = 1ULL << 63U;
+}
+
+/** Write the strings of range (anything that converts to string_view) to os, which should be opened in binary mode, in the SString8TableFormat */
+template<class Range>
+void writeSString8Table(std::ostream& os, const Range& range) // test - SString8TableTestRoundTrip
+{
+    using namespace SString8TableFormat;
+    Header header = {};
+    memcpy(header.m_Magic, magic, sizeof(magic));
+    for (const auto& item : range)
+    {
+        const std::string_view str(item);
+        ++header.m_Count;
+        if (str.size() > 7)
+            header.m_BlobSize += sizeof(uint64_t) + str.size() + 1;
+    }
+    header.m_BlobOffset = sizeof(Header) + header.m_Count * sizeof(uint64_t);
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    uint64_t blobOffset = 0;
+    for (const auto& item : range)
+    {
+        const std::string_view str(item);
+        uint64_t entry = 0;
+        if (str.size() <= 7)
+        {
+            entry = SString8Detail::SString8Data::makeBufferWord(str.data(), str.size());
+        }
+        else
+        {
+            entry = blobEntryBit | blobOffset;
+            blobOffset += sizeof(uint64_t) + str.size() + 1;
+        }
+        os.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    }
+    for (const auto& item : range)
+    {
+        const std::string_view str(item);
+        if (str.size() <= 7)
+            continue;
+        const uint64_t len = str.size();
+        os.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        os.write(str.data(), static_cast<std::streamsize>(str.size()));
+        os.put('\0');
+    }
+}
+
+/**
+A string table file (see SString8TableFormat), memory mapped read only.
+The header is checked when the file is opened; each entry is checked against the size of the file as it is read.
+Strings of 8 to 8191 chars are returned as SString8s borrowing the mapped chars, so they must not outlive the view.
+*/
+class SString8TableView
+{
+public:
+    /** Map the file.  Throws std::system_error if it can't be mapped, and std::runtime_error if it isn't a string table */
+    explicit SString8TableView(const std::filesystem::path& path); // test - SString8TableTestRoundTrip
+    SString8TableView(SString8TableView&& rhs) noexcept; // test - SString8TableTestRoundTrip
+    SString8TableView& operator=(SString8TableView&& rhs) noexcept; // test - SString8TableTestRoundTrip
+    SString8TableView(const SString8TableView&) = delete;
+    SString8TableView& operator=(const SString8TableView&) = delete;
+
+    size_t size() const noexcept { return m_Count; } // test - SString8TableTestRoundTrip
+
+    /** The chars of entry pos (which must be less than size()), in place in the mapping.  Throws std::runtime_error if the entry is corrupt */
+    std::string_view view(size_t pos) const // test - SString8TableTestRoundTrip
+    {
+        const auto pEntry = m_File.data() + sizeof(SString8TableFormat::Header) + pos * sizeof(uint64_t);
+        uint64_t entry;
+        memcpy(&entry, pEntry, sizeof(entry));
+        if ((entry & SString8TableFormat::blobEntryBit) == 0)
+        {
+            // a buffer word: the length is 7 less byte 7, and the chars are the entry's own bytes
+            const auto len = 7U - static_cast<size_t>(entry >> 56U);
+            if (len > 7)
+                throw std::runtime_error("SString8TableView - corrupt entry");
+            return std::string_view(pEntry, len);
+        }
+        const auto offset = entry & ~SString8TableFormat::blobEntryBit;
+        uint64_t len;
+        if (offset > m_BlobSize || m_BlobSize - offset < sizeof(len))
+            throw std::runtime_error("SString8TableView - corrupt entry");
+        memcpy(&len, m_pBlob + offset, sizeof(len));
+        // the chars must be followed by their null terminator, as operator[] borrows them
+        if (m_BlobSize - offset - sizeof(len) <= len || m_pBlob[offset + sizeof(len) + len] != '\0')
+            throw std::runtime_error("SString8TableView - corrupt entry");
+        return std::string_view(m_pBlob + offset + sizeof(len), static_cast<size_t>(len));
+    }
+
+    /** Entry pos as an SString8: a buffer string, a borrowed string (8 to 8191 chars) referring to the mapping, or for longer strings a copy */
+    SString8 operator[](size_t pos) const // test - SString8TableTestRoundTrip
+    {
+        const auto str = view(pos);
+        if (str.size() <= 7)
+            return SString8(str);
+        return SString8::borrow(str);
+    }
+
+private:
+    SString8Detail::MappedFile m_File;
+    size_t m_Count = 0;
+    const char* m_pBlob = nullptr;
+    size_t m_BlobSize = 0;
+};
@@ -0,0 +1,100 @@
+#include "SString8Writer.h"
+
+#include <algorithm>
+#include <system_error>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <sys/uio.h>
+#endif
+
+SString8Writer::SString8Writer(Handle handle, size_t copyBelow)
+    : m_Handle(handle)
+    , m_CopyBelow(std::min(copyBelow, stagingSize / 8U))
+    , m_pStaging(new char[stagingSize + 8U])
+    , m_pStagingEnd(m_pStaging.get() + stagingSize)
+    , m_pStagingPos(m_pStaging.get())
+    , m_pRunStart(m_pStaging.get())
+{
+    m_Segments.reserve(maxSegments);
+}
+
+SString8Writer::~SString8Writer()
+{
+    try
+    {
+        flush();
+    }
+    catch (...)
+    {
+    }
+}
+
+void SString8Writer::flush()
+{
+    closeRun();
+    try
+    {
+        writeSegments();
+    }
+    catch (...)
+    {
+        // what was pending is dropped all the same
+        m_Segments.clear();
+        m_pStagingPos = m_pStaging.get();
+        m_pRunStart = m_pStagingPos;
+        throw;
+    }
+    m_Segments.clear();
+    m_pStagingPos = m_pStaging.get();
+    m_pRunStart = m_pStagingPos;
+}
+
+void SString8Writer::writeSegments()
+{
+#if defined(_WIN32)
+    for (const auto& segment : m_Segments)
+    {
+        auto p = segment.m_p;
+        auto left = segment.m_Size;
+        while (left != 0)
+        {
+            const auto toWrite = static_cast<DWORD>(std::min<size_t>(left, 1U << 30U));
+            DWORD written = 0;
+            if (!WriteFile(m_Handle, p, toWrite, &written, nullptr))
+                throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "SString8Writer - can't write");
+            p += written;
+            left -= written;
+        }
+    }
+#else
+    iovec iov[maxSegments];
+    for (size_t i = 0; i < m_Segments.size(); ++i)
+        iov[i] = iovec{ const_cast<char*>(m_Segments[i].m_p), m_Segments[i].m_Size };
+    auto pIov = iov;
+    auto count = m_Segments.size();
+    while (count != 0)
+    {
+        const auto written = writev(m_Handle, pIov, static_cast<int>(count));
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::generic_category(), "SString8Writer - can't write");
+        }
+        // a short write (eg to a pipe) carries on from part way through a segment
+        auto left = static_cast<size_t>(written);
+        for (; count != 0 && left >= pIov->iov_len; ++pIov, --count)
+            left -= pIov->iov_len;
+        if (count != 0)
+        {
+            pIov->iov_base = static_cast<char*>(pIov->iov_base) + left;
+            pIov->iov_len -= left;
+        }
+    }
+#endif
+}
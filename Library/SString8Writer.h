@@ -0,0 +1,137 @@
+#pragma once
+
+#include "SString8.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+Writes many SString8s, eg the fields of millions of records, to a file descriptor (a HANDLE on Windows) with a gathering write of many strings per system call.
+
+A string of copyBelow chars or more isn't copied: the write refers to its chars where they are, so they must stay valid and unchanged until the next flush() (or the destructor).
+Anything shorter - most SString8s, and separators - is copied into a staging buffer, as a few chars cost less to copy than they would as a separate entry of the write.
+A buffer string, whose chars are in the SString8 itself, is always copied, as its whole 8 byte word.
+
+No error is seen until the flush that writes the chars.  The destructor flushes, but can only ignore an error, so call flush() first to see it.
+On Windows, which has no gathering write for ordinary buffers, each run of chars is written with WriteFile.
+*/
+class SString8Writer
+{
+public:
+#if defined(_WIN32)
+    using Handle = void*;
+#else
+    using Handle = int;
+#endif
+
+    static constexpr size_t defaultCopyBelow = 128;
+
+    /** Writes to handle, which stays open afterwards.  copyBelow is limited to 1/8th of the staging buffer */
+    explicit SString8Writer(Handle handle, size_t copyBelow = defaultCopyBelow); // test - SString8WriterTestWrite
+    ~SString8Writer();
+    // the pending writes refer to the staging buffer, which doesn't move, but the writer is not something to pass around
+    SString8Writer(const SString8Writer&) = delete;
+    SString8Writer& operator=(const SString8Writer&) = delete;
+
+    /** chars, which must stay valid until the next flush if they aren't copied */
+    void write(std::string_view chars) // test - SString8WriterTestWrite
+    {
+        if (chars.size() < m_CopyBelow)
+            copy(chars.data(), chars.size());
+        else
+            refer(chars.data(), chars.size());
+    }
+
+    template<class Alloc>
+    void write(const basic_SString8<Alloc>& str) // test - SString8WriterTestWrite
+    {
+        const auto& storage = SString8Detail::SString8Access::storage(str);
+        if (storage.isBuffer())
+        {
+            // the whole word in one store, which the staging buffer has room for past its end, and then just its chars kept
+            if (static_cast<size_t>(m_pStagingEnd - m_pStagingPos) < 7U)
+                flush();
+            const auto word = storage.m_Storage.m_pLargeStr;
+            memcpy(m_pStagingPos, &word, sizeof(word));
+            m_pStagingPos += 7U - (word >> 56U);
+            return;
+        }
+        write(std::string_view(str.data(), str.size()));
+    }
+
+    /** Each of strings, with separator between them and terminator after the last, eg "\t" and "\n" for a row of a TSV file */
+    template<class Range>
+    void writeAll(const Range& strings, std::string_view separator = {}, std::string_view terminator = {}) // test - SString8WriterTestWriteAll
+    {
+        bool first = true;
+        for (const auto& str : strings)
+        {
+            if (!first)
+                write(separator);
+            first = false;
+            write(str);
+        }
+        write(terminator);
+    }
+
+    /** Writes everything pending.  Throws std::system_error if the write fails, after which what was pending is dropped */
+    void flush(); // test - SString8WriterTestWrite
+
+private:
+    struct Segment
+    {
+        const char* m_p;
+        size_t m_Size;
+    };
+
+    static constexpr size_t stagingSize = 64 * 1024;
+    // the most segments in a gathering write (IOV_MAX on Linux)
+    static constexpr size_t maxSegments = 1024;
+
+    void copy(const char* p, size_t len)
+    {
+        // an empty string_view may have no chars to point to, which memcpy isn't given even with a length of 0
+        if (len == 0)
+            return;
+        if (static_cast<size_t>(m_pStagingEnd - m_pStagingPos) < len)
+            flush();
+        memcpy(m_pStagingPos, p, len);
+        m_pStagingPos += len;
+    }
+
+    void refer(const char* p, size_t len)
+    {
+        if (len == 0)
+            return;
+        // the run of copied chars before this, then these in place, leaving room for a run after them
+        if (m_Segments.size() + 3U > maxSegments)
+            flush();
+        closeRun();
+        m_Segments.push_back(Segment{ p, len });
+    }
+
+    /** Ends the run of chars copied since the last segment, as a segment of its own */
+    void closeRun()
+    {
+        if (m_pStagingPos != m_pRunStart)
+        {
+            m_Segments.push_back(Segment{ m_pRunStart, static_cast<size_t>(m_pStagingPos - m_pRunStart) });
+            m_pRunStart = m_pStagingPos;
+        }
+    }
+
+    void writeSegments();
+
+    Handle m_Handle;
+    size_t m_CopyBelow;
+    // with 8 bytes to spare past m_pStagingEnd for the word of a buffer string
+    std::unique_ptr<char[]> m_pStaging;
+    char* m_pStagingEnd;
+    char* m_pStagingPos;
+    char* m_pRunStart;
+    std::vector<Segment> m_Segments;
+};
@@ -0,0 +1,112 @@
+#include "SString8Column.h"
+
+#include "PintTest.h"
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    std::vector<std::string> makeStrings()
+    {
+        std::vector<std::string> strs;
+        for (const size_t len : { 0U, 1U, 7U, 8U, 20U, 254U, 255U, 8191U, 8192U, 40000U, 16383U, 12U })
+            strs.push_back(std::string(len, static_cast<char>('a' + strs.size())));
+        strs.push_back(std::string("embedded\0null", 13));
+        return strs;
+    }
+}
+
+TEST(SString8ColumnTestAppend)
+{
+    const auto strs = makeStrings();
+    SString8Column column;
+    EXPECT_TRUE(column.empty());
+    size_t arenaBytes = 0;
+    for (const auto& str : strs)
+    {
+        column.push_back(str);
+        if (str.size() >= 8 && str.size() <= 8191)
+            arenaBytes += str.size() + 1;
+    }
+    EXPECT_EQ(column.size(), strs.size());
+    EXPECT_EQ(column.arenaBytes(), arenaBytes);
+    for (size_t i = 0; i < strs.size(); ++i)
+    {
+        EXPECT_TRUE(column[i] == strs[i]) << i;
+        EXPECT_TRUE(column.entry(i) == strs[i]) << i;
+        // inline strings stay inline, and the ones in the arena are borrowed
+        const auto len = strs[i].size();
+        EXPECT_EQ(column.entry(i).isBorrowed(), len >= 8 && len <= 8191) << i;
+        EXPECT_EQ(column.entry(i).data()[len], '\0') << i;
+    }
+
+    // the arena holds the chars back to back, in the order they were added
+    EXPECT_TRUE(column[4].data() == column[3].data() + column[3].size() + 1);
+
+    size_t i = 0;
+    for (const auto& entry : column)
+        EXPECT_TRUE(entry == strs[i++]);
+    EXPECT_EQ(i, strs.size());
+
+    // moving the column doesn't move the chars
+    const auto pChars = column[4].data();
+    auto moved = std::move(column);
+    EXPECT_TRUE(moved[4].data() == pChars);
+    EXPECT_TRUE(moved[4] == strs[4]);
+
+    // and both can be added to afterwards, without sharing the arena chunk that moved
+    // (in different orders, so that chars written over each other would show)
+    for (size_t j = 0; j < strs.size(); ++j)
+    {
+        column.push_back(strs[j]);
+        moved.push_back(strs[strs.size() - 1 - j]);
+    }
+    SString8Column assigned;
+    assigned.push_back(strs[3]);
+    assigned = std::move(moved);
+    for (const auto& str : strs)
+        moved.push_back(str);
+    assigned.push_back(strs[4]);
+    for (size_t j = 0; j < strs.size(); ++j)
+    {
+        EXPECT_TRUE(column[j] == strs[j]) << j;
+        EXPECT_TRUE(assigned[j] == strs[j]) << j;
+        EXPECT_TRUE(assigned[strs.size() + j] == strs[strs.size() - 1 - j]) << j;
+        EXPECT_TRUE(moved[j] == strs[j]) << j;
+    }
+    EXPECT_TRUE(assigned[2 * strs.size()] == strs[4]);
+    EXPECT_EQ(column.size(), strs.size());
+    EXPECT_EQ(assigned.size(), 2 * strs.size() + 1);
+    EXPECT_EQ(moved.size(), strs.size());
+}
+
+TEST(SString8ColumnTestClear)
+{
+    SString8Column column;
+    column.reserve(100000);
+    const std::string text(30, 'c');
+    for (size_t i = 0; i < 100000; ++i)
+        column.push_back(text);
+    EXPECT_EQ(column.arenaBytes(), 100000U * 31U);
+    const auto capacity = column.arenaCapacity();
+    EXPECT_TRUE(capacity >= column.arenaBytes());
+    EXPECT_TRUE(capacity < column.arenaBytes() + SString8Detail::CharArena::chunkSize);
+
+    // a second batch of the same size reuses the chunks
+    column.clear();
+    EXPECT_TRUE(column.empty());
+    EXPECT_EQ(column.arenaBytes(), 0U);
+    EXPECT_EQ(column.arenaCapacity(), capacity);
+    for (size_t i = 0; i < 100000; ++i)
+        column.push_back(std::to_string(i) + text);
+    EXPECT_TRUE(column[99999] == "99999" + text);
+    column.push_back(std::string(20000, 'b'));
+    EXPECT_TRUE(column[100000] == std::string(20000, 'b'));
+
+    column.clear(true);
+    EXPECT_EQ(column.arenaCapacity(), 0U);
+    column.push_back("after a release");
+    EXPECT_TRUE(column[0] == "after a release");
+}
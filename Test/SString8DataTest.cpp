@@ -9,6 +9,11 @@
 #include <string>
 #include <utility>
 #include <string_view>
+#include <algorithm>
+#include <cstdlib>
+#if defined(__GLIBC__)
+#include <malloc.h> // malloc_usable_size
+#endif
 
 using namespace SString8Detail;
 
@@ -76,17 +81,9 @@ TEST(SString8DataTestData)
                 EXPECT_EQ(p, data2.getAsPtr()) << str.size();
             }
             EXPECT_TRUE(data.getStorageType() >= SString8Data::StorageType::SMALL);
-            if (data.getStorageType() == SString8Data::StorageType::SMALL)
-            {
-                if (str.size() % 2 == 0)
-                    EXPECT_EQ(data2.capacity(), data2.size()) << str.size();
-                else
-                    EXPECT_EQ(data2.capacity(), data2.size() + 1) << str.size();
-            }
-            else
-            {
-                EXPECT_EQ(data2.capacity(), data2.size()) << str.size();
-            }
+            // even if small, and rounded up to fill the malloc size class
+            EXPECT_EQ(data2.capacity(), SString8Data::usableCapacity(SString8Data::calcCapacity(data2.size()))) << str.size();
+            EXPECT_GE(data2.capacity(), data2.size()) << str.size();
         }
         EXPECT_TRUE(true);
     }
@@ -123,7 +120,8 @@ TEST(SString8DataTestData)
         EXPECT_FALSE(data.isMedium()) << sz;
         EXPECT_FALSE(data.isLarge()) << sz;
         EXPECT_EQ(sz, data.size()) << sz;
-        EXPECT_TRUE(data.capacity() == sz || data.capacity() == sz+1) << data.capacity() << " " << sz;
+        EXPECT_EQ(data.capacity(), SString8Data::usableCapacity(SString8Data::calcCapacity(sz))) << data.capacity() << " " << sz;
+        EXPECT_EQ(data.capacity() % 2, 0U) << sz;
     }
     for (const auto sz : { 255Ull, ((1ULL << 15U) - 1U) })
     {
@@ -135,7 +133,7 @@ TEST(SString8DataTestData)
         EXPECT_TRUE(data.isMedium()) << sz;
         EXPECT_FALSE(data.isLarge()) << sz;
         EXPECT_EQ(sz, data.size()) << sz;
-        EXPECT_EQ(data.capacity(), sz);
+        EXPECT_EQ(data.capacity(), SString8Data::usableCapacity(sz));
     }
     for (const auto sz : { (1ULL << 15U) })
     {
@@ -147,7 +145,7 @@ TEST(SString8DataTestData)
         EXPECT_FALSE(data.isMedium()) << sz;
         EXPECT_TRUE(data.isLarge()) << sz;
         EXPECT_EQ(sz, data.size()) << sz;
-        EXPECT_EQ(data.capacity(), sz);
+        EXPECT_EQ(data.capacity(), SString8Data::usableCapacity(sz));
     }
 
     for (const std::string_view str1 : strs)
@@ -197,6 +195,127 @@ TEST(SString8DataTestgetDataAndSize)
     }
 }
 
+TEST(SString8DataTestdecode)
+{
+    for (const auto sz : { 0ULL, 7Ull, 8ULL, 9ULL, 253Ull , 254Ull, 255Ull , 256Ull, ((1ULL << 15U) - 1U), (1ULL << 15U), ((1ULL << 15U) + 1U) })
+    {
+        const std::string str(sz, 'a');
+        const SString8Data data(str.data());
+        const auto decoded = data.decode();
+        EXPECT_EQ(decoded.m_pData, data.data()) << sz;
+        EXPECT_EQ(decoded.m_Size, data.size()) << sz;
+        EXPECT_EQ(decoded.m_Capacity, data.capacity()) << sz;
+        EXPECT_TRUE(decoded.m_Type == data.getStorageType()) << sz;
+        EXPECT_EQ(decoded.m_Type == SString8Data::StorageType::BUFFER, data.isBuffer()) << sz;
+        EXPECT_EQ(decoded.m_Type == SString8Data::StorageType::SMALL, data.isSmall()) << sz;
+        EXPECT_EQ(decoded.m_Type == SString8Data::StorageType::MEDIUM, data.isMedium()) << sz;
+        EXPECT_EQ(decoded.m_Type == SString8Data::StorageType::LARGE, data.isLarge()) << sz;
+    }
+}
+
+TEST(SString8DataTestBorrow)
+{
+    for (const auto sz : { 8ULL, 9ULL, 254ULL, 255ULL, 8191ULL })
+    {
+        // odd addresses are fine, as the address isn't stored in the pointer bits
+        const std::string str = "x" + std::string(sz, 'b');
+        SString8Data data;
+        data.borrow(str.data() + 1, sz);
+        EXPECT_TRUE(data.isBorrowed()) << sz;
+        EXPECT_TRUE(data.getStorageType() == SString8Data::StorageType::BORROWED) << sz;
+        const auto decoded = data.decode();
+        EXPECT_EQ(decoded.m_pData, str.data() + 1) << sz;
+        EXPECT_EQ(decoded.m_Size, sz) << sz;
+        EXPECT_EQ(decoded.m_Capacity, sz) << sz;
+
+        const SString8Data copy(data);
+        EXPECT_EQ(copy.m_Storage.m_pLargeStr, data.m_Storage.m_pLargeStr) << sz;
+
+        data.makeWritable();
+        EXPECT_FALSE(data.isBorrowed()) << sz;
+        EXPECT_TRUE(data.data() != str.data() + 1) << sz;
+        EXPECT_TRUE(std::string_view(data.data(), data.size()) == std::string_view(str).substr(1)) << sz;
+    }
+
+    // only 13 bits for the size
+    const std::string tooLong(8192, 'l');
+    SString8Data data;
+    data.borrow(tooLong.data(), tooLong.size());
+    EXPECT_TRUE(data.isMedium());
+}
+
+TEST(SString8DataTestcalcGrowthCapacity)
+{
+    for (const auto oldCap : { 7ULL, 8ULL, 14ULL, 100ULL, 126ULL, 127ULL, 254ULL, 255ULL, 1000ULL, (1ULL << 14U), ((1ULL << 15U) - 1U), (1ULL << 15U), (1ULL << 20U) })
+    {
+        for (const auto extra : { 1ULL, 2ULL, 100ULL, 1000ULL, (1ULL << 16U) })
+        {
+            const auto required = oldCap + extra;
+            const auto cap = SString8Data::calcGrowthCapacity(oldCap, required);
+            EXPECT_GE(cap, required) << oldCap << " " << extra;
+            EXPECT_GE(cap, std::min<size_t>(2 * oldCap, SString8Data::max_size_small)) << oldCap << " " << extra;
+            EXPECT_EQ(cap, SString8Data::calcCapacity(cap)) << oldCap << " " << extra;
+            // the allocation fills its 16 byte size class, unless clamped at the top of the small or medium tiers
+            const auto allocSize = cap + SString8Data::headerSize(cap) + 1;
+            const auto clamped = cap == SString8Data::max_size_small || cap == SString8Data::fifeteen_bites_set;
+            EXPECT_TRUE(clamped || allocSize % 16 == 0 || (cap <= SString8Data::max_size_small && allocSize % 16 == 15)) << oldCap << " " << extra << " " << cap;
+        }
+    }
+}
+
+TEST(SString8DataTestShrinkToFit)
+{
+    const auto sizes = { 0ULL, 3ULL, 7ULL, 8ULL, 9ULL, 253ULL, 254ULL, 255ULL, 256ULL, ((1ULL << 15U) - 1U), (1ULL << 15U), ((1ULL << 15U) + 1U) };
+    for (const auto from : sizes)
+    {
+        for (const auto to : sizes)
+        {
+            if (to > from)
+                continue;
+            const std::string text(from, 's');
+            SString8Data data(text);
+            data.assign(text.data(), to);
+            EXPECT_EQ(data.size(), to) << from << " " << to;
+            data.shrinkToFit();
+            EXPECT_EQ(data.size(), to) << from << " " << to;
+            EXPECT_EQ(data.capacity(), (to <= 7) ? 7U : SString8Data::usableCapacity(SString8Data::calcCapacity(to))) << from << " " << to;
+            EXPECT_EQ(data.isBuffer(), to <= 7) << from << " " << to;
+            EXPECT_EQ(data.isSmall(), to > 7 && to <= SString8Data::max_size_small) << from << " " << to;
+            EXPECT_EQ(data.isMedium(), to > SString8Data::max_size_small && to <= SString8Data::fifeteen_bites_set) << from << " " << to;
+            EXPECT_EQ(data.isLarge(), to > SString8Data::fifeteen_bites_set) << from << " " << to;
+            EXPECT_TRUE(std::string_view(data.data(), data.size()) == std::string_view(text).substr(0, to)) << from << " " << to;
+            EXPECT_EQ(data.data()[to], '\0') << from << " " << to;
+            // and it can grow again from there
+            data.append("xyz", 3);
+            EXPECT_TRUE(std::string_view(data.data(), data.size()) == std::string(to, 's') + "xyz") << from << " " << to;
+        }
+    }
+
+    // an empty heap string shrinks to the empty buffer, which is all zero apart from byte 7
+    SString8Data data;
+    data.reserve(100);
+    data.shrinkToFit();
+    EXPECT_EQ(data.m_Storage.m_pLargeStr, SString8Data().m_Storage.m_pLargeStr);
+}
+
+TEST(SString8DataTestClear)
+{
+    for (const auto sz : { 0ULL, 7ULL, 8ULL, 300ULL, (1ULL << 16U) })
+    {
+        SString8Data kept(std::string(sz, 'c'));
+        const auto cap = kept.capacity();
+        kept.clear(false);
+        EXPECT_EQ(kept.size(), 0U) << sz;
+        EXPECT_EQ(kept.capacity(), cap) << sz;
+        EXPECT_EQ(kept.data()[0], '\0') << sz;
+
+        SString8Data released(std::string(sz, 'c'));
+        released.clear(true);
+        EXPECT_TRUE(released.isBuffer()) << sz;
+        EXPECT_EQ(released.m_Storage.m_pLargeStr, SString8Data().m_Storage.m_pLargeStr) << sz;
+    }
+}
+
 TEST(SString8DataTestreserve)
 {
     const auto sizes = { 0ULL, 7Ull, 8ULL, 9ULL, 253Ull , 254Ull, 255Ull , 256Ull, ((1ULL << 15U) - 1U), (1ULL << 15U), ((1ULL << 15U) + 1U) };
@@ -208,10 +327,8 @@ TEST(SString8DataTestreserve)
         EXPECT_EQ(0, szz) << sz;
         if (sz <= 7)
             EXPECT_EQ(7, cap) << sz;
-        else if (data.isSmall())
-            EXPECT_TRUE(sz == cap || sz+1 == cap) << sz << " " << cap;
         else
-            EXPECT_EQ(sz, cap) << sz;
+            EXPECT_EQ(SString8Data::usableCapacity(SString8Data::calcCapacity(sz)), cap) << sz;
     }
 
     for (const auto sz1 : sizes)
@@ -381,3 +498,54 @@ TEST(SString8DataTestGetSetPtr)
         EXPECT_EQ(0, strcmp(data.m_Storage.m_Buffer.m_Buffer, shortStr));
     }
 }
+
+TEST(SString8DataTestBufferIsCanonical)
+{
+    // whatever was there before, a buffer string is always stored the same way
+    SString8Data data("1234567");
+    data.setSize(2);
+    const SString8Data expected("12");
+    EXPECT_EQ(data.m_Storage.m_pLargeStr, expected.m_Storage.m_pLargeStr);
+
+    SString8Data data2(std::string(100, 'a'));
+    data2.allocateWithDeallocate("12", 2);
+    EXPECT_EQ(data2.m_Storage.m_pLargeStr, expected.m_Storage.m_pLargeStr);
+
+    SString8Data data3;
+    data3.append("1", 1);
+    data3.push_back('2');
+    EXPECT_EQ(data3.m_Storage.m_pLargeStr, expected.m_Storage.m_pLargeStr);
+}
+
+TEST(SString8DataTestusableCapacity)
+{
+    for (size_t cap = 8; cap < 70000; cap += (cap < 600) ? 1U : 37U)
+    {
+        const auto desired = SString8Data::calcCapacity(cap);
+        const auto usable = SString8Data::usableCapacity(desired);
+        EXPECT_GE(usable, desired) << cap;
+        // stays in the tier, with small capacities even
+        EXPECT_EQ(SString8Data::headerSize(usable), SString8Data::headerSize(desired)) << cap;
+        if (usable <= SString8Data::max_size_small)
+        {
+            EXPECT_EQ(usable % 2, 0U) << cap;
+        }
+        // and the allocation is no bigger than the one it replaces really is
+        const auto allocated = SString8Data::allocationSize(usable);
+        EXPECT_LE(allocated, SString8Detail::MallocSizeClasses::usableSize(SString8Data::allocationSize(desired))) << cap;
+    }
+    // the pmr allocator's resource could be anything, so its capacities aren't rounded
+    EXPECT_EQ(SString8Detail::basic_SString8Data<SString8PmrAllocator<char>>::usableCapacity(100), 100U);
+    // slab blocks are 16 byte classes: 101 bytes are 112 from the slab
+    EXPECT_EQ(SString8Detail::basic_SString8Data<SString8SlabAllocator<char>>::usableCapacity(100), 110U);
+
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+    // malloc really does give at least this much (sometimes more, if what was left of a free chunk was too small to split off)
+    for (size_t bytes = 1; bytes < 5000; ++bytes)
+    {
+        auto p = malloc(bytes);
+        EXPECT_GE(malloc_usable_size(p), SString8Detail::MallocSizeClasses::usableSize(bytes)) << bytes;
+        free(p);
+    }
+#endif
+}
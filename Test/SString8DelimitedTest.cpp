@@ -0,0 +1,171 @@
+#include "SString8Delimited.h"
+
+#include "PintTest.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /** A file of contents in the temp directory, removed again when it goes out of scope (so declare it before the tables loaded from it) */
+    class TempCsv
+    {
+    public:
+        TempCsv(std::string_view name, std::string_view contents)
+            : m_Path(std::filesystem::temp_directory_path() / ("SString8DelimitedTest_" + std::string(name) + ".csv"))
+        {
+            std::ofstream os(m_Path, std::ios::binary);
+            os.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        }
+
+        ~TempCsv()
+        {
+            std::error_code error;
+            std::filesystem::remove(m_Path, error);
+        }
+
+        TempCsv(const TempCsv&) = delete;
+        TempCsv& operator=(const TempCsv&) = delete;
+
+        const std::filesystem::path& path() const noexcept { return m_Path; }
+
+    private:
+        std::filesystem::path m_Path;
+    };
+
+    /** Every value of table, a row at a time */
+    std::vector<std::vector<std::string>> rows(const SString8DelimitedTable& table)
+    {
+        std::vector<std::vector<std::string>> result(table.rowCount());
+        for (size_t column = 0; column < table.columnCount(); ++column)
+        {
+            EXPECT_EQ(table.column(column).size(), table.rowCount());
+            for (size_t row = 0; row < table.rowCount(); ++row)
+                result[row].emplace_back(table.column(column)[row]);
+        }
+        return result;
+    }
+}
+
+TEST(SString8DelimitedTestLoad)
+{
+    const std::string longValue(100, 'L');
+    const TempCsv file("Load", "\xEF\xBB\xBFid,name,city\r\n1,Bristol,England\r\n2,,\n3,a name longer than the buffer," + longValue + "\n4\n5,x");
+    for (const auto longValues : { SString8LongValues::ARENA, SString8LongValues::BORROW_MAPPING })
+    {
+        SString8DelimitedOptions options;
+        options.m_LongValues = longValues;
+        SString8DelimitedTable loaded(file.path(), options);
+        // moving keeps the values valid, and leaves nothing behind
+        auto table = std::move(loaded);
+        EXPECT_EQ(loaded.columnCount(), 0U);
+        EXPECT_EQ(loaded.rowCount(), 0U);
+        EXPECT_EQ(table.columnCount(), 3U);
+        EXPECT_EQ(table.rowCount(), 5U);
+        EXPECT_EQ(table.name(0), "id");
+        EXPECT_EQ(table.name(2), "city");
+        EXPECT_EQ(table.columnIndex("name"), 1U);
+        EXPECT_EQ(table.columnIndex("missing"), 3U);
+        const std::vector<std::vector<std::string>> expected = {
+            { "1", "Bristol", "England" },
+            { "2", "", "" },
+            { "3", "a name longer than the buffer", longValue },
+            { "4", "", "" },
+            { "5", "x", "" } };
+        EXPECT_TRUE(rows(table) == expected);
+        EXPECT_TRUE(table.column(1)[2].isBorrowed());
+        EXPECT_FALSE(table.column(1)[0].isBorrowed());
+
+        loaded = std::move(table);
+        EXPECT_TRUE(rows(loaded) == expected);
+        EXPECT_EQ(table.columnCount(), 0U);
+        EXPECT_EQ(table.rowCount(), 0U);
+    }
+
+    // the file itself is unchanged by borrowing from it
+    {
+        SString8DelimitedOptions options;
+        options.m_LongValues = SString8LongValues::BORROW_MAPPING;
+        const SString8DelimitedTable table(file.path(), options);
+        std::ifstream is(file.path(), std::ios::binary);
+        const std::string contents((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(contents.find('\0'), std::string::npos);
+    }
+
+    // without a header, and as TSV
+    const TempCsv tsvFile("Tsv", "a\tbb\tccc\n\td\t\n");
+    SString8DelimitedOptions tsv;
+    tsv.m_Delimiter = '\t';
+    tsv.m_Header = false;
+    const SString8DelimitedTable table(tsvFile.path(), tsv);
+    EXPECT_EQ(table.name(0), "");
+    const std::vector<std::vector<std::string>> expected = { { "a", "bb", "ccc" }, { "", "d", "" } };
+    EXPECT_TRUE(rows(table) == expected);
+
+    const TempCsv emptyFile("Empty", "");
+    const SString8DelimitedTable empty(emptyFile.path());
+    EXPECT_EQ(empty.columnCount(), 0U);
+    EXPECT_EQ(empty.rowCount(), 0U);
+    const TempCsv headerOnlyFile("HeaderOnly", "a,b\n");
+    const SString8DelimitedTable headerOnly(headerOnlyFile.path());
+    EXPECT_EQ(headerOnly.columnCount(), 2U);
+    EXPECT_EQ(headerOnly.rowCount(), 0U);
+}
+
+TEST(SString8DelimitedTestThreads)
+{
+    // enough for several threads' chunks, with long values at the chunk boundaries somewhere
+    std::string contents = "key,value,note\n";
+    std::vector<std::vector<std::string>> expected;
+    uint64_t seed = 99;
+    while (contents.size() < 5 * 1024 * 1024)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        expected.push_back({ std::to_string(expected.size()), std::string((seed >> 33U) % 20, 'v'), ((seed >> 60U) == 0) ? std::string(9000, 'n') : "" });
+        contents += expected.back()[0] + "," + expected.back()[1] + "," + expected.back()[2] + "\n";
+    }
+    const TempCsv file("Threads", contents);
+    for (const size_t threadCount : { 1U, 3U, 8U })
+    {
+        for (const auto longValues : { SString8LongValues::ARENA, SString8LongValues::BORROW_MAPPING })
+        {
+            SString8DelimitedOptions options;
+            options.m_ThreadCount = threadCount;
+            options.m_LongValues = longValues;
+            const SString8DelimitedTable table(file.path(), options);
+            EXPECT_TRUE(rows(table) == expected) << threadCount;
+        }
+    }
+}
+
+TEST(SString8DelimitedTestErrors)
+{
+    const TempCsv tooMany("TooMany", "a,b\n1,2\n1,2,3\n");
+    bool thrown = false;
+    try
+    {
+        SString8DelimitedTable table(tooMany.path());
+    }
+    catch (const std::runtime_error& error)
+    {
+        thrown = std::string_view(error.what()).find("line 3") != std::string_view::npos;
+    }
+    EXPECT_TRUE(thrown);
+
+    bool missing = false;
+    try
+    {
+        SString8DelimitedTable table(std::filesystem::temp_directory_path() / "SString8DelimitedTest_DoesNotExist.csv");
+    }
+    catch (const std::system_error&)
+    {
+        missing = true;
+    }
+    EXPECT_TRUE(missing);
+}
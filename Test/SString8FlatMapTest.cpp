@@ -0,0 +1,275 @@
+#include "SString8FlatMap.h"
+
+#include "PintTest.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    /** Keys covering every tier, short enough and long enough to exercise both ways of comparing keys */
+    std::vector<std::string> makeKeys(size_t count)
+    {
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto key = std::to_string(i);
+            switch (i % 4)
+            {
+            case 0: break;
+            case 1: key += "abcdefgh"; break;
+            case 2: key.insert(0, 300, 'm'); break;
+            default: key.insert(0, std::string(1, '\0')); break;
+            }
+            keys.push_back(std::move(key));
+        }
+        return keys;
+    }
+}
+
+TEST(SString8FlatMapTestInsert)
+{
+    SString8FlatMap<int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.capacity(), 0U);
+    EXPECT_TRUE(map.find("abc") == map.end());
+
+    const auto [it, inserted] = map.try_emplace(SString8("abc"), 1);
+    EXPECT_TRUE(inserted);
+    EXPECT_TRUE(it->first == "abc");
+    EXPECT_EQ(it->second, 1);
+    const auto [it2, inserted2] = map.try_emplace(SString8("abc"), 2);
+    EXPECT_FALSE(inserted2);
+    EXPECT_EQ(it2->second, 1);
+    EXPECT_TRUE(it == it2);
+
+    EXPECT_TRUE(map.insert({ SString8("a long key, on the heap"), 3 }).second);
+    EXPECT_FALSE(map.insert({ SString8("a long key, on the heap"), 4 }).second);
+    EXPECT_EQ(map.at("a long key, on the heap"), 3);
+
+    map.insert_or_assign(SString8("abc"), 5);
+    EXPECT_EQ(map.at("abc"), 5);
+    map.insert_or_assign(SString8("def"), 6);
+    EXPECT_EQ(map.at("def"), 6);
+
+    map[SString8("ghi")] = 7;
+    ++map[SString8("ghi")];
+    EXPECT_EQ(map.at("ghi"), 8);
+    EXPECT_EQ(map.size(), 4U);
+
+    // a short key that happens to be held on the heap is still found by its chars
+    SString8 onHeap("xyz");
+    onHeap.reserve(100);
+    map[std::move(onHeap)] = 9;
+    EXPECT_EQ(map.at("xyz"), 9);
+    EXPECT_EQ(map.at(SString8("xyz")), 9);
+    SString8 onHeap2("xyz");
+    onHeap2.reserve(100);
+    EXPECT_EQ(map.at(onHeap2), 9);
+    map[onHeap2] = 10;
+    EXPECT_EQ(map.size(), 5U);
+    EXPECT_EQ(map.at("xyz"), 10);
+}
+
+TEST(SString8FlatMapTestFind)
+{
+    SString8FlatMap<size_t> map;
+    const auto keys = makeKeys(5000);
+    for (size_t i = 0; i < keys.size(); ++i)
+        EXPECT_TRUE(map.try_emplace(SString8(keys[i]), i).second) << keys[i];
+    EXPECT_EQ(map.size(), keys.size());
+    EXPECT_TRUE(map.load_factor() <= 0.875f);
+
+    const auto& cmap = map;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        const auto it = cmap.find(SString8(keys[i]));
+        ASSERT_TRUE(it != cmap.end()) << keys[i];
+        EXPECT_EQ(it->second, i);
+        EXPECT_EQ(cmap.at(SString8(keys[i])), i);
+        EXPECT_TRUE(cmap.contains(SString8(keys[i])));
+        EXPECT_EQ(cmap.count(SString8(keys[i])), 1U);
+    }
+    EXPECT_TRUE(cmap.find(SString8("not there")) == cmap.end());
+    EXPECT_FALSE(cmap.contains(SString8("x")));
+    EXPECT_EQ(cmap.count(SString8("")), 0U);
+
+    bool threw = false;
+    try
+    {
+        (void)cmap.at(SString8("not there"));
+    }
+    catch (const std::out_of_range&)
+    {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+
+    // every element is visited exactly once
+    std::vector<int> seen(keys.size());
+    size_t visited = 0;
+    for (const auto& [key, value] : cmap)
+    {
+        ASSERT_TRUE(value < keys.size());
+        EXPECT_TRUE(key == keys[value]);
+        ++seen[value];
+        ++visited;
+    }
+    EXPECT_EQ(visited, keys.size());
+    for (const auto count : seen)
+        EXPECT_EQ(count, 1);
+}
+
+TEST(SString8FlatMapTestHeterogeneous)
+{
+    using namespace std::string_literals;
+    SString8FlatMap<int> map;
+    map["seven"] = 7;
+    map[std::string_view("eight")] = 8;
+    map["a string longer than seven chars"s] = 9;
+    map["\0\0"s] = 10;
+    EXPECT_TRUE(map.try_emplace("seven", 0).second == false);
+    EXPECT_TRUE(map.try_emplace("nine", 11).second);
+
+    EXPECT_EQ(map.at("seven"), 7);
+    EXPECT_EQ(map.at(std::string_view("eight")), 8);
+    EXPECT_EQ(map.at("a string longer than seven chars"s), 9);
+    EXPECT_EQ(map.at("\0\0"s), 10);
+    EXPECT_EQ(map.at(SString8("\0\0"s)), 10);
+    EXPECT_FALSE(map.contains("\0"s));
+    EXPECT_FALSE(map.contains(std::string_view("sevens")));
+    EXPECT_FALSE(map.contains("a string longer than seven char"));
+    EXPECT_EQ(map.count(std::string("nine")), 1U);
+
+    EXPECT_EQ(map.erase("seven"), 1U);
+    EXPECT_EQ(map.erase("seven"), 0U);
+    EXPECT_EQ(map.erase("a string longer than seven chars"s), 1U);
+    EXPECT_EQ(map.size(), 3U);
+}
+
+TEST(SString8FlatMapTestErase)
+{
+    // random inserts and erases, checked against std::unordered_map
+    SString8FlatMap<uint32_t> map;
+    std::unordered_map<std::string, uint32_t> expected;
+    const auto keys = makeKeys(600);
+    uint64_t seed = 12345;
+    for (uint32_t i = 0; i < 50000; ++i)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        const auto& key = keys[(seed >> 33U) % keys.size()];
+        if ((seed >> 62U) == 0)
+        {
+            EXPECT_EQ(map.erase(key), expected.erase(key));
+        }
+        else
+        {
+            map.insert_or_assign(SString8(key), i);
+            expected[key] = i;
+        }
+        ASSERT_EQ(map.size(), expected.size());
+    }
+    for (const auto& key : keys)
+    {
+        const auto it = expected.find(key);
+        const auto it8 = map.find(key);
+        EXPECT_EQ(it == expected.end(), it8 == map.end()) << key;
+        if (it != expected.end() && it8 != map.end())
+        {
+            EXPECT_EQ(it->second, it8->second) << key;
+        }
+    }
+    // erase inserts deleted markers, which must be reused rather than growing the table for ever
+    EXPECT_TRUE(map.capacity() <= 2048U);
+
+    // erase by iterator, while iterating
+    for (auto it = map.begin(); it != map.end();)
+    {
+        if (it->second % 2 == 0)
+            it = map.erase(it);
+        else
+            ++it;
+    }
+    for (const auto& [key, value] : map)
+        EXPECT_EQ(value % 2, 1U);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.begin() == map.end());
+    EXPECT_TRUE(map.find(keys[0]) == map.end());
+    map[keys[0]] = 1;
+    EXPECT_EQ(map.size(), 1U);
+}
+
+TEST(SString8FlatMapTestCopyMove)
+{
+    SString8FlatMap<std::string> map;
+    const auto keys = makeKeys(100);
+    for (const auto& key : keys)
+        map[key] = key;
+    for (size_t i = 0; i < keys.size(); i += 3)
+        map.erase(keys[i]);
+
+    SString8FlatMap<std::string> copy(map);
+    EXPECT_EQ(copy.size(), map.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        EXPECT_EQ(copy.contains(keys[i]), i % 3 != 0) << keys[i];
+        if (i % 3 != 0)
+        {
+            EXPECT_EQ(copy.at(keys[i]), keys[i]);
+        }
+    }
+
+    SString8FlatMap<std::string> moved(std::move(copy));
+    EXPECT_EQ(moved.size(), map.size());
+    EXPECT_TRUE(copy.empty());
+    EXPECT_TRUE(copy.find(keys[1]) == copy.end());
+
+    SString8FlatMap<std::string> assigned;
+    assigned["x"] = "y";
+    assigned = map;
+    EXPECT_EQ(assigned.size(), map.size());
+    EXPECT_FALSE(assigned.contains("x"));
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.at(keys[1]), keys[1]);
+
+    SString8FlatMap<std::string> reserved(1000);
+    const auto capacity = reserved.capacity();
+    EXPECT_TRUE(capacity >= 1000U);
+    for (const auto& key : keys)
+        reserved[key];
+    EXPECT_EQ(reserved.capacity(), capacity);
+}
+
+TEST(SString8FlatSetTest)
+{
+    SString8FlatSet set;
+    const auto keys = makeKeys(1000);
+    for (const auto& key : keys)
+        EXPECT_TRUE(set.insert(key).second);
+    for (const auto& key : keys)
+        EXPECT_FALSE(set.insert(SString8(key)).second);
+    const SString8 existing(keys[5]);
+    EXPECT_FALSE(set.insert(existing).second);
+    EXPECT_EQ(set.size(), keys.size());
+    for (const auto& key : keys)
+    {
+        const auto it = set.find(std::string_view(key));
+        ASSERT_TRUE(it != set.end());
+        EXPECT_TRUE(*it == key);
+    }
+    size_t count = 0;
+    for (const auto& key : set)
+    {
+        EXPECT_TRUE(set.contains(key));
+        ++count;
+    }
+    EXPECT_EQ(count, keys.size());
+    EXPECT_EQ(set.erase(SString8(keys[0])), 1U);
+    EXPECT_FALSE(set.contains(keys[0]));
+}
@@ -0,0 +1,90 @@
+#include "SString8InternPool.h"
+
+#include "PintTest.h"
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+TEST(SString8InternPoolTestIntern)
+{
+    SString8InternPool pool;
+    const auto word = [](const SString8& str)
+        {
+            uint64_t result;
+            memcpy(&result, &str, sizeof(result));
+            return result;
+        };
+
+    // short strings are buffer strings, and need nothing from the pool
+    const auto get = pool.intern("GET");
+    EXPECT_TRUE(get == "GET");
+    EXPECT_TRUE(SString8InternPool::equal(get, pool.intern(std::string("GET"))));
+    EXPECT_EQ(pool.size(), 0U);
+
+    // the same chars from different places give the same word, referring to one copy in the pool
+    std::string host = "host-0001.example.com";
+    const auto a = pool.intern(host);
+    const auto b = pool.intern(std::string_view(host));
+    EXPECT_TRUE(a.isBorrowed());
+    EXPECT_TRUE(a == host);
+    EXPECT_EQ(word(a), word(b));
+    EXPECT_TRUE(a.data() != host.data());
+    host[0] = 'H';
+    EXPECT_TRUE(a == "host-0001.example.com");
+    const auto c = pool.intern(host);
+    EXPECT_FALSE(SString8InternPool::equal(a, c));
+    EXPECT_TRUE(SString8InternPool::equal(a, b));
+    EXPECT_TRUE(SString8InternPool::equal(b, a));
+    EXPECT_FALSE(SString8InternPool::equal(a, get));
+    EXPECT_EQ(pool.size(), 2U);
+    EXPECT_EQ(pool.arenaBytes(), 2 * (host.size() + 1));
+
+    // copies stay borrowed, and changing one doesn't change the pool
+    auto copy = a;
+    EXPECT_EQ(word(copy), word(a));
+    copy += "!";
+    EXPECT_FALSE(copy.isBorrowed());
+    EXPECT_TRUE(pool.intern("host-0001.example.com") == "host-0001.example.com");
+    EXPECT_EQ(word(pool.intern("host-0001.example.com")), word(a));
+
+    // the longest string that can be borrowed, and longer ones
+    for (const size_t len : { 8191U, 8192U, 100000U })
+    {
+        const std::string text(len, 'L');
+        const auto first = pool.intern(text);
+        const auto second = pool.intern(text);
+        EXPECT_TRUE(first == text) << len;
+        EXPECT_TRUE(SString8InternPool::equal(first, second)) << len;
+        EXPECT_EQ(first.isBorrowed(), len <= 8191) << len;
+        EXPECT_FALSE(SString8InternPool::equal(first, pool.intern(std::string(len, 'M')))) << len;
+    }
+    EXPECT_EQ(pool.size(), 8U);
+
+    // many threads interning overlapping sets of strings all get the same words
+    constexpr size_t threadCount = 4;
+    constexpr size_t distinct = 2048;
+    std::vector<std::vector<uint64_t>> words(threadCount);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&pool, &words, &word, t]()
+            {
+                words[t].resize(distinct);
+                for (size_t i = 0; i < distinct; ++i)
+                {
+                    // each thread goes through them in a different order (2t+1 is odd, so this visits every n)
+                    const auto n = (i * (2 * t + 1)) % distinct;
+                    const auto str = pool.intern("metric.name." + std::to_string(n));
+                    words[t][n] = word(str);
+                }
+            });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    for (size_t t = 1; t < threadCount; ++t)
+        EXPECT_TRUE(words[t] == words[0]) << t;
+    EXPECT_EQ(pool.size(), 8U + distinct);
+    EXPECT_TRUE(pool.intern("metric.name.1234") == "metric.name.1234");
+}
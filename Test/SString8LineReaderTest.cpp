@@ -0,0 +1,80 @@
+#include "SString8LineReader.h"
+
+#include "PintTest.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    /** The lines of text, as std::getline reads them */
+    std::vector<std::string> expectedLines(const std::string& text, char delim)
+    {
+        std::vector<std::string> lines;
+        std::istringstream is(text);
+        for (std::string line; std::getline(is, line, delim);)
+            lines.push_back(line);
+        return lines;
+    }
+
+    std::vector<std::string> readLines(SString8LineReader& reader)
+    {
+        std::vector<std::string> lines;
+        for (SString8 line; reader.getline(line);)
+            lines.emplace_back(line);
+        return lines;
+    }
+}
+
+TEST(SString8LineReaderTestText)
+{
+    for (const auto& text : std::vector<std::string>{ "", "\n", "\n\n", "a", "a\n", "a\nb", "one\r\ntwo\r\n", "short\n" + std::string(100, 'x') + "\n\nlast" })
+    {
+        SString8LineReader reader(text);
+        EXPECT_TRUE(readLines(reader) == expectedLines(text, '\n')) << text;
+        std::string_view view;
+        EXPECT_FALSE(reader.getline(view));
+    }
+
+    // more lines than a batch of delimiters, of every length up to a few blocks
+    std::string many;
+    for (size_t i = 0; i < 2000; ++i)
+        many += std::string(i % 70, static_cast<char>('a' + i % 26)) + "\n";
+    many += "no newline";
+    SString8LineReader reader(many);
+    EXPECT_TRUE(readLines(reader) == expectedLines(many, '\n'));
+
+    // in place, with another delimiter
+    SString8LineReader fields(std::string_view("a,bb,,ccc"), ',');
+    std::vector<std::string_view> views;
+    for (std::string_view view; fields.getline(view);)
+        views.push_back(view);
+    EXPECT_TRUE(views == std::vector<std::string_view>({ "a", "bb", "", "ccc" }));
+}
+
+TEST(SString8LineReaderTestFile)
+{
+    const auto path = std::filesystem::temp_directory_path() / "SString8LineReaderTest.txt";
+    std::string text;
+    for (size_t i = 0; i < 1000; ++i)
+        text += "line " + std::to_string(i) + "\n";
+    {
+        std::ofstream os(path, std::ios::binary);
+        os << text;
+    }
+    auto reader = SString8LineReader::fromFile(path);
+    // moving keeps the mapping
+    auto moved = std::move(reader);
+    EXPECT_TRUE(readLines(moved) == expectedLines(text, '\n'));
+
+    {
+        std::ofstream os(path, std::ios::binary);
+    }
+    auto empty = SString8LineReader::fromFile(path);
+    std::string_view view;
+    EXPECT_FALSE(empty.getline(view));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,84 @@
+#include "SString8.h"
+
+#include "PintTest.h"
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    using namespace SString8Detail;
+
+    /** Check every kernel against std::string_view, for every length up to 100, with matches in every block position */
+    void testKernels(Search::Level level)
+    {
+        // few distinct chars, so that there are plenty of partial matches, with a 0 and a char with the top bit set
+        const char alphabet[] = { 'a', 'b', 'c', '\0', '\xff' };
+        uint64_t seed = 42;
+        std::string buffer(200, 'a');
+        for (auto& ch : buffer)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            ch = alphabet[(seed >> 33U) % std::size(alphabet)];
+        }
+        const std::vector<std::string> needles = { "a", "\xff", "ab", "ca", "abc", std::string("a\0b", 3), "abcab", "abcaabca", "abcaabcab", "bbbbbbbbbbbbbbbbb", "z" };
+        const std::vector<std::string> sets = { "", "a", "z", "ab", std::string("\0\xff", 2), "abc", "abcz", "abcz\xff", std::string("abcdefghij\0", 11) };
+        for (size_t offset = 0; offset < 33; ++offset)
+        {
+            for (size_t len = 0; len <= 100; ++len)
+            {
+                // copied to an allocation of exactly len chars, so that a kernel reading past the end would be caught by a memory checker
+                const std::vector<char> exact(buffer.data() + offset, buffer.data() + offset + len);
+                const std::string_view text(exact.data(), len);
+                const auto p = exact.data();
+                for (const auto ch : alphabet)
+                {
+                    EXPECT_EQ(text.find(ch), Search::findChar(p, len, ch)) << int(level) << " " << offset << " " << len;
+                    EXPECT_EQ(text.rfind(ch), Search::rfindChar(p, len, ch)) << int(level) << " " << offset << " " << len;
+                }
+                for (const auto& needle : needles)
+                {
+                    EXPECT_EQ(text.find(needle), Search::find(p, len, needle.data(), needle.size())) << int(level) << " " << offset << " " << len << " " << needle;
+                    EXPECT_EQ(text.rfind(needle), Search::rfind(p, len, needle.data(), needle.size())) << int(level) << " " << offset << " " << len << " " << needle;
+                }
+                for (const auto& set : sets)
+                {
+                    EXPECT_EQ(text.find_first_of(set), Search::findOf(p, len, set.data(), set.size(), false)) << int(level) << " " << offset << " " << len << " " << set;
+                    EXPECT_EQ(text.find_first_not_of(set), Search::findOf(p, len, set.data(), set.size(), true)) << int(level) << " " << offset << " " << len << " " << set;
+                    EXPECT_EQ(text.find_last_of(set), Search::rfindOf(p, len, set.data(), set.size(), false)) << int(level) << " " << offset << " " << len << " " << set;
+                    EXPECT_EQ(text.find_last_not_of(set), Search::rfindOf(p, len, set.data(), set.size(), true)) << int(level) << " " << offset << " " << len << " " << set;
+                }
+            }
+        }
+    }
+}
+
+TEST(SString8SearchTestLevels)
+{
+    const auto best = Search::bestLevel();
+    EXPECT_EQ(Search::level(), best);
+    for (const auto level : { Search::Level::SCALAR, Search::Level::SSE2, Search::Level::AVX2 })
+    {
+        if (level > best)
+            continue;
+        Search::setLevel(level);
+        EXPECT_EQ(Search::level(), level);
+        testKernels(level);
+    }
+    // a level that the CPU doesn't have gives the best that it does
+    Search::setLevel(Search::Level::AVX2);
+    EXPECT_EQ(Search::level(), best);
+}
+
+TEST(SString8SearchTestSwar)
+{
+    EXPECT_EQ(Search::zeroBytes(0x0001000000FF0000ULL), 0x8000808080008080ULL);
+    // the byte above a 0 byte isn't flagged, even when it is 1 (which the usual formula gets wrong)
+    EXPECT_EQ(Search::zeroBytes(0x0101010101010100ULL), 0x0000000000000080ULL);
+    EXPECT_EQ(Search::lanes(0, 7), 0x0080808080808080ULL);
+    EXPECT_EQ(Search::lanes(2, 4), 0x0000000080800000ULL);
+    EXPECT_EQ(Search::lanes(3, 3), 0U);
+}
@@ -0,0 +1,108 @@
+#include "SString8.h"
+
+#include "PintTest.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+TEST(SString8SlabTestSizeClasses)
+{
+    using namespace SString8Detail;
+    for (size_t bytes = 1; bytes <= Slab::maxBlockSize; ++bytes)
+    {
+        auto p = Slab::allocate(bytes);
+        ASSERT_TRUE(p != nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % Slab::granularity, 0U) << bytes;
+        memset(p, 0x5A, bytes);
+        // freed blocks are reused, most recently freed first
+        Slab::free(p, bytes);
+        auto p2 = Slab::allocate(bytes);
+        EXPECT_EQ(p, p2) << bytes;
+        Slab::free(p2, bytes);
+    }
+
+    // enough blocks to need several chunks, all distinct
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < 10000; ++i)
+        blocks.push_back(Slab::allocate(32));
+    for (size_t i = 1; i < blocks.size(); ++i)
+        EXPECT_TRUE(blocks[i] != blocks[i - 1]);
+    for (auto p : blocks)
+        Slab::free(p, 32);
+}
+
+TEST(SString8SlabTestCrossThreadFree)
+{
+    using namespace SString8Detail;
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < 1000; ++i)
+        blocks.push_back(Slab::allocate(100));
+
+    // freed on another thread, and then handed back to this one when its own free list is empty
+    std::thread([&blocks]()
+        {
+            for (auto p : blocks)
+                Slab::free(p, 100);
+        }).join();
+    std::vector<void*> reused;
+    for (size_t i = 0; i < 1000; ++i)
+        reused.push_back(Slab::allocate(100));
+    size_t found = 0;
+    for (auto p : reused)
+        found += std::find(blocks.begin(), blocks.end(), p) != blocks.end() ? 1U : 0U;
+    EXPECT_EQ(found, blocks.size());
+    for (auto p : reused)
+        Slab::free(p, 100);
+
+    // blocks allocated on a thread which then exits stay valid, and can be freed anywhere
+    std::vector<SlabSString8> strs;
+    std::thread([&strs]()
+        {
+            for (size_t i = 0; i < 100; ++i)
+                strs.emplace_back(std::string(8 + i, 'x'));
+        }).join();
+    for (size_t i = 0; i < strs.size(); ++i)
+        EXPECT_TRUE(std::string_view(strs[i]) == std::string(8 + i, 'x'));
+    strs.clear();
+}
+
+TEST(SString8SlabTestString)
+{
+    static_assert(sizeof(SlabSString8) == 8);
+    for (const auto len : { 0U, 7U, 8U, 100U, 254U, 255U, 1000U, 40000U })
+    {
+        const std::string text(len, 's');
+        SlabSString8 str(text);
+        EXPECT_TRUE(std::string_view(str) == text) << len;
+        auto copy = str;
+        for (size_t i = 0; i < 300; ++i)
+            copy.push_back('t');
+        EXPECT_EQ(copy.size(), len + 300U);
+        EXPECT_TRUE(std::string_view(copy).substr(0, len) == text);
+        copy = str;
+        EXPECT_TRUE(copy == str);
+    }
+
+    // strings made and destroyed on several threads at once
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([t]()
+            {
+                std::vector<SlabSString8> strs(64);
+                for (size_t i = 0; i < 20000; ++i)
+                    strs[i % strs.size()] = SlabSString8(std::string(8 + (i * 7 + t) % 247, static_cast<char>('a' + t)));
+                for (const auto& str : strs)
+                {
+                    EXPECT_TRUE(str.size() >= 8U);
+                    EXPECT_EQ(str.data()[0], static_cast<char>('a' + t));
+                }
+            });
+    }
+    for (auto& thread : threads)
+        thread.join();
+}
@@ -0,0 +1,118 @@
+#include "SString8Sort.h"
+
+#include "PintTest.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /**
+    Strings of every tier, with lots of shared prefixes (some longer than 8 chars, so that the full comparison is needed), duplicates and embedded nulls.
+    1 in 8 has the long prefix, so for a lot of strings make it shorter (still a heap tier), or the copies of them are gigabytes
+    */
+    std::vector<SString8> makeStrings(size_t count, size_t longPrefix = 40000)
+    {
+        std::vector<SString8> strs;
+        strs.reserve(count);
+        uint64_t seed = 12345;
+        const std::string prefixes[] = { "", "a", "ab\0", "abcdefg", "abcdefgh", "abcdefghij", std::string(300, 'p'), std::string(longPrefix, 'q') };
+        for (size_t i = 0; i < count; ++i)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            auto str = prefixes[(seed >> 33U) % std::size(prefixes)];
+            const auto extra = (seed >> 40U) % 4;
+            for (size_t j = 0; j < extra; ++j)
+                str.push_back(static_cast<char>("\0ab\xff"[(seed >> (44U + 2 * j)) & 3U]));
+            strs.emplace_back(str);
+            // some short strings in heap allocations, which have to sort the same as buffer strings
+            if ((seed >> 60U) == 0)
+                strs.back().reserve(100);
+        }
+        return strs;
+    }
+
+    bool sameOrder(const std::vector<SString8>& lhs, const std::vector<SString8>& rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    /** Where each heap string's chars are, which tells apart equal strings in different allocations (and null for a buffer string, whose chars move with it) */
+    std::vector<const char*> addresses(const std::vector<SString8>& strs)
+    {
+        std::vector<const char*> result;
+        for (const auto& str : strs)
+        {
+            const auto pData = str.data();
+            result.push_back((pData == reinterpret_cast<const char*>(&str)) ? nullptr : pData);
+        }
+        return result;
+    }
+
+    /** The addresses of strs once stable sorted, worked out without moving them */
+    std::vector<const char*> stableSortedAddresses(const std::vector<SString8>& strs)
+    {
+        std::vector<size_t> order(strs.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&strs](size_t lhs, size_t rhs) { return strs[lhs] < strs[rhs]; });
+        const auto unsorted = addresses(strs);
+        std::vector<const char*> result;
+        for (const auto i : order)
+            result.push_back(unsorted[i]);
+        return result;
+    }
+}
+
+TEST(SString8SortTest)
+{
+    for (const size_t count : { 0U, 1U, 2U, 10U, 64U, 65U, 1000U, 20000U })
+    {
+        auto strs = makeStrings(count);
+        auto expected = strs;
+        std::sort(expected.begin(), expected.end());
+        sort_sstring8(strs.begin(), strs.end());
+        EXPECT_TRUE(sameOrder(strs, expected)) << count;
+    }
+
+    // all 7 chars or fewer, which sort on the key alone
+    std::vector<SString8> shortStrs;
+    for (size_t i = 0; i < 5000; ++i)
+        shortStrs.emplace_back(std::to_string((i * 7919) % 1000));
+    auto expected = shortStrs;
+    std::sort(expected.begin(), expected.end());
+    sort_sstring8(shortStrs.data(), shortStrs.data() + shortStrs.size());
+    EXPECT_TRUE(sameOrder(shortStrs, expected));
+    std::array<SString8, 3> arr = { SString8("c"), SString8("a"), SString8("b") };
+    sort_sstring8(arr.begin(), arr.end());
+    EXPECT_TRUE(arr[0] == "a" && arr[1] == "b" && arr[2] == "c");
+
+    // stable: equal heap strings keep their order, which their addresses tell (a few, which are sorted without the radix passes, and many)
+    for (const size_t count : { 50U, 20000U })
+    {
+        auto strs = makeStrings(count);
+        const auto expectedAddresses = stableSortedAddresses(strs);
+        stable_sort_sstring8(strs.begin(), strs.end());
+        EXPECT_TRUE(addresses(strs) == expectedAddresses) << count;
+    }
+}
+
+TEST(SString8SortTestParallel)
+{
+    // enough strings for the parallel path (64K and up), but not long ones
+    const auto strs = makeStrings(300000, 500);
+    auto expected = strs;
+    std::sort(expected.begin(), expected.end());
+    for (const size_t threads : { 4U, 3U, 0U })
+    {
+        auto copy = strs;
+        const auto expectedAddresses = stableSortedAddresses(copy);
+        parallel_sort_sstring8(copy.begin(), copy.end(), threads);
+        EXPECT_TRUE(sameOrder(copy, expected)) << threads;
+        EXPECT_TRUE(addresses(copy) == expectedAddresses) << threads;
+    }
+}
@@ -0,0 +1,108 @@
+#include "SString8Split.h"
+
+#include "PintTest.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    /** The fields of record, split the slow way */
+    std::vector<std::string> expectedFields(std::string_view record, char delimiter)
+    {
+        std::vector<std::string> fields;
+        for (size_t start = 0;;)
+        {
+            const auto end = record.find(delimiter, start);
+            fields.emplace_back(record.substr(start, (end == std::string_view::npos) ? std::string_view::npos : end - start));
+            if (end == std::string_view::npos)
+                return fields;
+            start = end + 1;
+        }
+    }
+
+    void expectFields(const std::vector<SString8>& fields, std::string_view record, char delimiter)
+    {
+        const auto expected = expectedFields(record, delimiter);
+        EXPECT_EQ(fields.size(), expected.size()) << record;
+        for (size_t i = 0; i < fields.size() && i < expected.size(); ++i)
+            EXPECT_EQ(std::string_view(fields[i]), expected[i]) << record << " " << i;
+    }
+}
+
+TEST(SString8SplitTestVector)
+{
+    std::vector<SString8> fields;
+    for (const auto* pRecord : { "", ",", "a", "a,b", ",a,,b,", "id,name,city,population", "1,Bristol,England,472400", "abcdefg,abcdefgh,a much longer field than the buffer holds,,x" })
+    {
+        EXPECT_EQ(split_sstring8(pRecord, ',', fields), expectedFields(pRecord, ',').size());
+        expectFields(fields, pRecord, ',');
+    }
+    EXPECT_EQ(split_sstring8("a\tb,c\t", '\t', fields), 3U);
+    expectFields(fields, "a\tb,c\t", '\t');
+
+    // an embedded null is an ordinary char
+    const std::string withNull("ab\0c,d", 6);
+    EXPECT_EQ(split_sstring8(withNull, ',', fields), 2U);
+    expectFields(fields, withNull, ',');
+
+    // more delimiters than a batch, at every position relative to a block
+    uint64_t seed = 7;
+    for (size_t len = 0; len < 300; ++len)
+    {
+        std::string record;
+        for (size_t i = 0; i < len; ++i)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            record.push_back(((seed >> 60U) < 6) ? ',' : static_cast<char>('a' + (seed >> 33U) % 26));
+        }
+        split_sstring8(record, ',', fields);
+        expectFields(fields, record, ',');
+    }
+    std::string delimitersOnly(200, ';');
+    EXPECT_EQ(split_sstring8(delimitersOnly, ';', fields), 201U);
+    expectFields(fields, delimitersOnly, ';');
+}
+
+TEST(SString8SplitTestReuse)
+{
+    std::vector<SString8> fields;
+    split_sstring8("a field of more than seven chars,short,another long field to allocate", ',', fields);
+    const auto pFirst = fields[0].data();
+    const auto pThird = fields[2].data();
+    const auto capacity = fields.capacity();
+
+    // the heap strings keep their allocations, whatever goes in them
+    split_sstring8("shorter than before,tiny,x", ',', fields);
+    expectFields(fields, "shorter than before,tiny,x", ',');
+    EXPECT_EQ(fields[0].data(), pFirst);
+    EXPECT_EQ(fields[2].data(), pThird);
+    EXPECT_EQ(fields.capacity(), capacity);
+
+    // fewer fields shrinks the vector, and more grows it
+    split_sstring8("one", ',', fields);
+    expectFields(fields, "one", ',');
+    EXPECT_EQ(fields[0].data(), pFirst);
+    split_sstring8("1,2,3,4,5", ',', fields);
+    expectFields(fields, "1,2,3,4,5", ',');
+}
+
+TEST(SString8SplitTestArray)
+{
+    SString8 fields[3];
+    fields[1].reserve(50);
+    const auto pSecond = fields[1].data();
+    EXPECT_EQ(split_sstring8("a,bb,ccc", ',', fields, 3), 3U);
+    EXPECT_EQ(fields[0], "a");
+    EXPECT_EQ(fields[1], "bb");
+    EXPECT_EQ(fields[1].data(), pSecond);
+    EXPECT_EQ(fields[2], "ccc");
+
+    // more fields than room counts them all, but writes only the first maxFields
+    EXPECT_EQ(split_sstring8("x,y,z,w,v", ',', fields, 2), 5U);
+    EXPECT_EQ(fields[0], "x");
+    EXPECT_EQ(fields[1], "y");
+    EXPECT_EQ(fields[2], "ccc");
+    EXPECT_EQ(split_sstring8("x,y", ',', fields, 0), 2U);
+}
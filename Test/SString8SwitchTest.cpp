@@ -0,0 +1,73 @@
+#include "SString8Switch.h"
+
+#include "PintTest.h"
+#include <string>
+#include <string_view>
+
+namespace
+{
+    using Methods = SString8Switch<"GET", "PUT", "POST", "HEAD", "DELETE", "OPTIONS", "", "CONNECT_UDP", "PROPPATCH">;
+
+    /** What a dispatcher would do: the switch cases are the indices of the keys */
+    int methodCode(const SString8& method)
+    {
+        switch (Methods::find(method))
+        {
+        case Methods::indexOf("GET"): return 1;
+        case Methods::indexOf("POST"): return 2;
+        case Methods::indexOf("CONNECT_UDP"): return 3;
+        case Methods::npos: return -1;
+        default: return 0;
+        }
+    }
+}
+
+TEST(SString8SwitchTestFind)
+{
+    static_assert(Methods::size == 9);
+    static_assert(Methods::indexOf("GET") == 0);
+    static_assert(Methods::indexOf("PROPPATCH") == 8);
+    static_assert(Methods::find(std::string_view("OPTIONS")) == 5);
+    static_assert(Methods::find(std::string_view("CONNECT_UDP")) == 7);
+    static_assert(Methods::find(std::string_view("")) == 6);
+    static_assert(Methods::find(std::string_view("GE")) == Methods::npos);
+    static_assert(Methods::find(SString8("HEAD")) == 3);
+
+    const std::string_view keys[] = { "GET", "PUT", "POST", "HEAD", "DELETE", "OPTIONS", "", "CONNECT_UDP", "PROPPATCH" };
+    for (size_t i = 0; i < std::size(keys); ++i)
+    {
+        EXPECT_EQ(Methods::find(keys[i]), i) << keys[i];
+        EXPECT_EQ(Methods::find(SString8(keys[i])), i) << keys[i];
+        // a heap string of 7 chars or fewer matches too
+        SString8 heap(std::string(100, 'x'));
+        heap.assign(keys[i]);
+        EXPECT_EQ(Methods::find(heap), i) << keys[i];
+        EXPECT_EQ(Methods::find(PmrSString8(keys[i])), i) << keys[i];
+    }
+
+    // misses: prefixes, extensions, case, embedded nulls, and long strings the length of a key
+    for (const std::string_view miss : { "G", "GETS", "get", "POSTS", "OPTIONS ", "CONNECT_UD", "CONNECT_UDX", "PROPPATCHX", "QROPPATCH" })
+    {
+        EXPECT_EQ(Methods::find(miss), Methods::npos) << miss;
+        EXPECT_EQ(Methods::find(SString8(miss)), Methods::npos) << miss;
+    }
+    EXPECT_EQ(Methods::find(std::string_view("GET\0", 4)), Methods::npos);
+    EXPECT_EQ(Methods::find(std::string_view("\0", 1)), Methods::npos);
+
+    EXPECT_EQ(methodCode(SString8("GET")), 1);
+    EXPECT_EQ(methodCode(SString8("POST")), 2);
+    EXPECT_EQ(methodCode(SString8("CONNECT_UDP")), 3);
+    EXPECT_EQ(methodCode(SString8("PUT")), 0);
+    EXPECT_EQ(methodCode(SString8("TRACE")), -1);
+
+    // a single key, and lots of keys
+    using One = SString8Switch<"x">;
+    static_assert(One::find(std::string_view("x")) == 0);
+    EXPECT_EQ(One::find(SString8("y")), One::npos);
+    using Many = SString8Switch<"a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p", "q", "r", "s", "t", "u", "v", "w", "x", "y", "z",
+        "aa", "bb", "cc", "dd", "ee", "ff", "gg", "hh", "ii", "jj", "kk", "ll", "mm", "nn", "oo", "pp">;
+    for (char c = 'a'; c <= 'z'; ++c)
+        EXPECT_EQ(Many::find(SString8(std::string(1, c))), static_cast<size_t>(c - 'a'));
+    EXPECT_EQ(Many::find(SString8("pp")), 41U);
+    EXPECT_EQ(Many::find(SString8("qq")), Many::npos);
+}
@@ -0,0 +1,171 @@
+#include "SString8Table.h"
+
+#include "PintTest.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    std::filesystem::path tablePath(std::string_view name)
+    {
+        return std::filesystem::temp_directory_path() / ("SString8TableTest_" + std::string(name) + ".bin");
+    }
+}
+
+TEST(SString8TableTestRoundTrip)
+{
+    std::vector<std::string> strs;
+    for (const size_t len : { 0U, 1U, 7U, 8U, 100U, 8191U, 8192U, 40000U })
+        strs.emplace_back(std::string(len, static_cast<char>('a' + strs.size())));
+    strs.emplace_back(std::string_view("nul\0", 4));
+    strs.emplace_back(std::string_view("embedded\0null", 13));
+    const auto path = tablePath("RoundTrip");
+    {
+        std::ofstream os(path, std::ios::binary);
+        writeSString8Table(os, strs);
+    }
+
+    SString8TableView table(path);
+    EXPECT_EQ(table.size(), strs.size());
+    const auto pBase = table.view(3).data();
+    for (size_t i = 0; i < strs.size(); ++i)
+    {
+        EXPECT_TRUE(table.view(i) == strs[i]) << i;
+        const auto str = table[i];
+        EXPECT_TRUE(str == strs[i]) << i;
+        const auto len = strs[i].size();
+        EXPECT_EQ(str.isBorrowed(), len >= 8 && len <= 8191) << i;
+        // borrowed strings are read in place, with no copy
+        if (str.isBorrowed())
+        {
+            EXPECT_TRUE(std::as_const(str).data() == table.view(i).data()) << i;
+        }
+    }
+
+    // moving the view keeps the mapping
+    auto moved = std::move(table);
+    EXPECT_EQ(moved.size(), strs.size());
+    EXPECT_TRUE(moved.view(3).data() == pBase);
+    SString8TableView other(path);
+    other = std::move(moved);
+    EXPECT_TRUE(other.view(4) == strs[4]);
+
+    // an empty table
+    const auto emptyPath = tablePath("Empty");
+    {
+        std::ofstream os(emptyPath, std::ios::binary);
+        writeSString8Table(os, std::vector<std::string>());
+    }
+    EXPECT_EQ(SString8TableView(emptyPath).size(), 0U);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(emptyPath);
+}
+
+TEST(SString8TableTestCorrupt)
+{
+    const auto path = tablePath("Corrupt");
+    const auto expectError = [&path](const std::string& contents, bool system)
+        {
+            {
+                std::ofstream os(path, std::ios::binary);
+                os << contents;
+            }
+            bool thrown = false;
+            try
+            {
+                SString8TableView table(path);
+            }
+            catch (const std::system_error&)
+            {
+                thrown = system;
+            }
+            catch (const std::runtime_error&)
+            {
+                thrown = !system;
+            }
+            EXPECT_TRUE(thrown) << contents.size();
+        };
+
+    std::string good;
+    {
+        std::ofstream os(path, std::ios::binary);
+        const std::vector<std::string> strs = { "short", "a longer string", std::string(300, 'x') };
+        writeSString8Table(os, strs);
+    }
+    {
+        std::ifstream is(path, std::ios::binary);
+        good.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    }
+
+    expectError("", false);
+    expectError("not a string table, but long enough to have a header", false);
+    // truncated blob
+    expectError(good.substr(0, good.size() - 10), false);
+    // an entry count too big for the file
+    auto tooMany = good;
+    tooMany[8] = 100;
+    expectError(tooMany, false);
+
+    // an entry pointing outside the blob is found when it is read
+    auto badEntry = good;
+    badEntry[32 + 8 + 1] = 0x7F;
+    {
+        std::ofstream os(path, std::ios::binary);
+        os << badEntry;
+    }
+    SString8TableView table(path);
+    EXPECT_TRUE(table.view(0) == "short");
+    bool thrown = false;
+    try
+    {
+        table.view(1);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    EXPECT_TRUE(table.view(2) == std::string(300, 'x'));
+
+    // as is a string that isn't null terminated (entry 1's record is at the start of the blob, after the header and 3 entries)
+    const auto unterminatedPath = tablePath("Unterminated");
+    auto unterminated = good;
+    unterminated[32 + 3 * 8 + 8 + std::string_view("a longer string").size()] = 'X';
+    {
+        std::ofstream os(unterminatedPath, std::ios::binary);
+        os << unterminated;
+    }
+    {
+        SString8TableView unterminatedTable(unterminatedPath);
+        thrown = false;
+        try
+        {
+            unterminatedTable[1];
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+        EXPECT_TRUE(unterminatedTable.view(2) == std::string(300, 'x'));
+    }
+    std::filesystem::remove(unterminatedPath);
+
+    std::filesystem::remove(path);
+    bool missing = false;
+    try
+    {
+        SString8TableView table(path);
+    }
+    catch (const std::system_error&)
+    {
+        missing = true;
+    }
+    EXPECT_TRUE(missing);
+}
@@ -5,6 +5,17 @@
 #include <cstring>
 #include <stdexcept>
 #include <string_view>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <iterator>
+#include <list>
+#include <unordered_set>
+#include <functional>
+#include <memory_resource>
+#include <utility>
+#include <thread>
+#include <type_traits>
 
 namespace
 {
@@ -147,6 +158,16 @@ TEST(String8TestConstructorCountChar)
         const auto str2 = std::string(i, 'D');
         testAreEqual(str1, str2, __LINE__);
     }
+    // a pair of the same type that isn't an iterator is a count and a char, as for std::string, not a range
+    {
+        const auto str1 = SString8(10, 65);
+        const auto str2 = std::string(10, 65);
+        testAreEqual(str1, str2, __LINE__);
+        SString8 str3;
+        str3.append(3, 'x');
+        str3.assign(2, 'y');
+        EXPECT_EQ(str3, "yy");
+    }
 }
 
 TEST(String8TestConstructorStringView)
@@ -302,6 +323,18 @@ TEST(String8TestConstructorInputItFirstLast)
     const std::string str1(std::begin(mutable_c_str) + 8, std::end(mutable_c_str) - 1);
     const SString8 str2(std::begin(mutable_c_str) + 8, std::end(mutable_c_str) - 1);
     testAreEqual(str1, str2, __LINE__);
+
+    // every tier, from forward and single pass iterators
+    for (const auto len : { 0U, 7U, 8U, 254U, 255U, 40000U })
+    {
+        std::string text(len, 'r');
+        if (len != 0)
+            text.back() = 'z';
+        const std::list<char> chars(text.begin(), text.end());
+        testAreEqual(text, SString8(chars.begin(), chars.end()), __LINE__);
+        std::istringstream is(text);
+        testAreEqual(text, SString8(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()), __LINE__);
+    }
 }
 
 TEST(String8TestConstructorInitialiserList)
@@ -636,6 +669,17 @@ TEST(SString8TestData)
     }
 }
 
+namespace
+{
+    /** The capacity that a string of sz chars gets: the buffer, or a heap allocation rounded up to fill its size class */
+    template<class Alloc>
+    size_t expectedCapacity(const basic_SString8<Alloc>&, size_t sz)
+    {
+        using Data = SString8Detail::basic_SString8Data<Alloc>;
+        return (sz <= 7) ? 7U : Data::usableCapacity(Data::calcCapacity(sz));
+    }
+}
+
 TEST(SString8TestSizeLength)
 {
     for (size_t len1 = 0; len1 < 34; ++len1)
@@ -647,7 +691,7 @@ TEST(SString8TestSizeLength)
         if (len1 <= 7)
             EXPECT_EQ(7, str81.capacity()) << len1 << " " << str81.capacity();
         else
-            EXPECT_TRUE(len1 == str81.capacity() || len1 + 1 == str81.capacity()) << len1 << " " << str81.capacity();
+            EXPECT_EQ(expectedCapacity(str81, len1), str81.capacity()) << len1 << " " << str81.capacity();
     }
 }
 
@@ -667,10 +711,7 @@ TEST(SString8Testreserve)
         data.reserve(sz);
         EXPECT_EQ(0, data.size()) << sz;
         const auto cap = data.capacity();
-        if (sz <= 7)
-            EXPECT_EQ(7, cap) << sz;
-        else
-            EXPECT_TRUE(sz == cap || sz + 1 == cap) << sz << " " << cap;
+        EXPECT_EQ(expectedCapacity(data, sz), cap) << sz << " " << cap;
     }
 
     for (const auto sz1 : sizes)
@@ -771,3 +812,1087 @@ TEST(String8TestOperatorEqStringViewLike)
         }
     }
 }
+
+TEST(SString8TestPushBack)
+{
+    std::string str1;
+    SString8 str2;
+    size_t capacityChanges = 0;
+    for (size_t i = 0; i < (1U << 17U); ++i)
+    {
+        const auto ch = static_cast<char>('a' + i % 26);
+        const auto oldCap = str2.capacity();
+        str1.push_back(ch);
+        str2.push_back(ch);
+        if (str2.capacity() != oldCap)
+            ++capacityChanges;
+        ASSERT_EQ(str1.size(), str2.size()) << i;
+        ASSERT_TRUE(str2.size() <= str2.capacity()) << i;
+        if ((i & (i + 1)) == 0 || i < 300) // check the contents at every length around the tier boundaries, and then at 2^n - 1
+            testAreEqual(str1, str2, __LINE__);
+    }
+    testAreEqual(str1, str2, __LINE__);
+    // geometric growth, so the number of reallocations is logarithmic in the length
+    EXPECT_TRUE(capacityChanges <= 18) << capacityChanges;
+}
+
+TEST(SString8TestAppend)
+{
+    const std::vector<size_t> lengths{ 0, 1, 3, 6, 7, 8, 9, 100, 253, 254, 255, 256, (1U << 15U) - 2U, (1U << 15U) - 1U, 1U << 15U };
+    for (const auto len1 : lengths)
+    {
+        for (const auto len2 : lengths)
+        {
+            const std::string start(len1, 'a');
+            const std::string extra(len2, 'b');
+            {
+                std::string str1(start);
+                SString8 str2(start);
+                str1.append(extra);
+                str2.append(extra);
+                testAreEqual(str1, str2, __LINE__);
+            }
+            {
+                std::string str1(start);
+                SString8 str2(start);
+                str1.append(SString8(extra));
+                str2.append(SString8(extra));
+                testAreEqual(str1, str2, __LINE__);
+            }
+            {
+                std::string str1(start);
+                SString8 str2(start);
+                str1.append(extra.data(), len2 / 2);
+                str2.append(extra.data(), len2 / 2);
+                testAreEqual(str1, str2, __LINE__);
+            }
+            {
+                std::string str1(start);
+                SString8 str2(start);
+                str1.append(extra.c_str());
+                str2.append(extra.c_str());
+                testAreEqual(str1, str2, __LINE__);
+            }
+            {
+                std::string str1(start);
+                SString8 str2(start);
+                str1.append(len2, 'c');
+                str2.append(len2, 'c');
+                testAreEqual(str1, str2, __LINE__);
+            }
+            {
+                std::string str1(start);
+                SString8 str2(start);
+                str1.append(extra, len2 / 2, 3);
+                str2.append(SString8(extra), len2 / 2, 3);
+                testAreEqual(str1, str2, __LINE__);
+            }
+            {
+                std::string str1(start);
+                SString8 str2(start);
+                str1.append(std::string_view(extra), len2 / 3);
+                str2.append(std::string_view(extra), len2 / 3);
+                testAreEqual(str1, str2, __LINE__);
+            }
+        }
+    }
+    {
+        std::string str1("abc");
+        SString8 str2("abc");
+        str1.append({ 'd', 'e', 'f', 'g', 'h' });
+        str2.append({ 'd', 'e', 'f', 'g', 'h' });
+        testAreEqual(str1, str2, __LINE__);
+    }
+    // appending to itself
+    for (const auto len : lengths)
+    {
+        std::string str1(len, 'x');
+        SString8 str2(str1);
+        str1.append(str1);
+        str2.append(str2);
+        testAreEqual(str1, str2, __LINE__);
+        str1.append(str1.data() + str1.size() / 2, str1.size() / 2);
+        str2.append(str2.data() + str2.size() / 2, str2.size() / 2);
+        testAreEqual(str1, str2, __LINE__);
+    }
+    {
+        const SString8 str("abc");
+        SString8 str2;
+        int count = 0;
+        try
+        {
+            str2.append(str, 3, 1);
+            ++count;
+            str2.append(str, 4, 1);
+            EXPECT_TRUE(false);
+        }
+        catch (std::out_of_range&)
+        {
+            EXPECT_EQ(count, 1);
+        }
+    }
+}
+
+TEST(SString8TestAppendInputIt)
+{
+    const std::string text("abcdefghijklmnopqrstuvwxyz");
+    {
+        std::string str1("12345");
+        SString8 str2("12345");
+        str1.append(text.begin(), text.end());
+        str2.append(text.begin(), text.end());
+        testAreEqual(str1, str2, __LINE__);
+    }
+    {
+        // single pass input iterators
+        std::istringstream in1(text);
+        std::istringstream in2(text);
+        std::string str1("12345");
+        SString8 str2("12345");
+        str1.append(std::istreambuf_iterator<char>(in1), std::istreambuf_iterator<char>());
+        str2.append(std::istreambuf_iterator<char>(in2), std::istreambuf_iterator<char>());
+        testAreEqual(str1, str2, __LINE__);
+    }
+}
+
+TEST(SString8TestOperatorPlusEq)
+{
+    std::string str1;
+    SString8 str2;
+    for (size_t i = 0; i < 300; ++i)
+    {
+        switch (i % 5)
+        {
+        case 0:
+            str1 += 'a';
+            str2 += 'a';
+            break;
+        case 1:
+            str1 += "bc";
+            str2 += "bc";
+            break;
+        case 2:
+            str1 += std::string("defghijk");
+            str2 += std::string("defghijk");
+            break;
+        case 3:
+            str1 += { 'l', 'm' };
+            str2 += { 'l', 'm' };
+            break;
+        default:
+            str1 += std::string(SString8("nop"));
+            str2 += SString8("nop");
+            break;
+        }
+        testAreEqual(str1, str2, __LINE__);
+    }
+}
+
+TEST(SString8TestInsert)
+{
+    const std::vector<size_t> lengths{ 0, 1, 6, 7, 8, 100, 254, 255, (1U << 15U) - 1U, 1U << 15U };
+    for (const auto len1 : lengths)
+    {
+        const std::string start = std::string(len1, 'a');
+        for (const auto len2 : lengths)
+        {
+            const std::string extra(len2, 'b');
+            for (const auto index : { size_t(0), len1 / 2, len1 })
+            {
+                {
+                    std::string str1(start);
+                    SString8 str2(start);
+                    str1.insert(index, extra);
+                    str2.insert(index, extra);
+                    testAreEqual(str1, str2, __LINE__);
+                }
+                {
+                    std::string str1(start);
+                    SString8 str2(start);
+                    str1.insert(index, len2, 'c');
+                    str2.insert(index, len2, 'c');
+                    testAreEqual(str1, str2, __LINE__);
+                }
+                {
+                    std::string str1(start);
+                    SString8 str2(start);
+                    str1.insert(index, extra.c_str());
+                    str2.insert(index, extra.c_str());
+                    testAreEqual(str1, str2, __LINE__);
+                }
+                {
+                    std::string str1(start);
+                    SString8 str2(start);
+                    str1.insert(index, extra, len2 / 2, 5);
+                    str2.insert(index, SString8(extra), len2 / 2, 5);
+                    testAreEqual(str1, str2, __LINE__);
+                }
+            }
+        }
+    }
+    // inserting from itself
+    for (const auto len : lengths)
+    {
+        std::string str1;
+        for (size_t i = 0; i < len; ++i)
+            str1.push_back(static_cast<char>('a' + i % 26));
+        SString8 str2(str1);
+        str1.insert(str1.size() / 2, str1);
+        str2.insert(str2.size() / 2, str2);
+        testAreEqual(str1, str2, __LINE__);
+        str1.insert(1 % (str1.size() + 1), str1.data(), str1.size() / 3);
+        str2.insert(1 % (str2.size() + 1), str2.data(), str2.size() / 3);
+        testAreEqual(str1, str2, __LINE__);
+    }
+    {
+        SString8 str("abc");
+        int count = 0;
+        try
+        {
+            str.insert(3, "d");
+            ++count;
+            str.insert(5, "e");
+            EXPECT_TRUE(false);
+        }
+        catch (std::out_of_range&)
+        {
+            EXPECT_EQ(count, 1);
+        }
+    }
+}
+
+TEST(SString8TestCompare)
+{
+    using namespace std::string_literals;
+    const std::vector<std::string> strs{ ""s, "\0"s, "a"s, "a\0"s, "a\0b"s, "a\0c"s, "ab"s, "abcdefg"s, "abcdefh"s, "abcdefgh"s, "b"s, "\xff"s, "abcdefghijklmnop"s, "abcdefghijklmnoq"s };
+    auto sign = [](int i) { return (i > 0) - (i < 0); };
+    for (const auto& str1 : strs)
+    {
+        for (const auto& str2 : strs)
+        {
+            const SString8 s81(str1);
+            const SString8 s82(str2);
+            EXPECT_EQ(sign(str1.compare(str2)), sign(s81.compare(s82))) << str1 << " " << str2;
+            EXPECT_EQ(sign(str1.compare(str2)), sign(s81.compare(std::string_view(str2)))) << str1 << " " << str2;
+            EXPECT_EQ(str1 == str2, s81 == s82) << str1 << " " << str2;
+            EXPECT_TRUE((str1 <=> str2) == (s81 <=> s82)) << str1 << " " << str2;
+
+            // the same strings held on the heap, and left over chars from a longer string in the buffer
+            SString8 heap1;
+            heap1.reserve(100);
+            heap1.append(str1);
+            SString8 reused2("zzzzzzz");
+            reused2 = str2.c_str();
+            reused2.append(str2.data() + strlen(str2.c_str()), str2.size() - strlen(str2.c_str()));
+            EXPECT_EQ(str1 == str2, heap1 == reused2) << str1 << " " << str2;
+            EXPECT_EQ(str1 == str2, reused2 == heap1) << str1 << " " << str2;
+            EXPECT_TRUE((str1 <=> str2) == (heap1 <=> reused2)) << str1 << " " << str2;
+            EXPECT_TRUE((str2 <=> str1) == (reused2 <=> heap1)) << str1 << " " << str2;
+        }
+        const SString8 s8(str1);
+        EXPECT_EQ(sign(std::string(str1.c_str()).compare("abc")), sign(s8.compare("abc"))) << str1;
+    }
+}
+
+TEST(SString8TestHash)
+{
+    using namespace std::string_literals;
+    std::vector<std::string> strs{ ""s, "\0"s, "a"s, "a\0"s, "ab"s, "abcdefg"s, "abcdefh"s, "abcdefgh"s, "abcdefgi"s, "abcdefghijklmnop"s, "abcdefghijklmnopq"s, std::string(300, 'x'), std::string(1U << 15U, 'y') };
+    const SString8Hash hasher;
+    for (const auto& str : strs)
+    {
+        const SString8 s8(str);
+        const auto h = std::hash<SString8>()(s8);
+        EXPECT_EQ(h, hasher(s8)) << str;
+        EXPECT_EQ(h, hasher(std::string_view(str))) << str;
+        EXPECT_EQ(h, hasher(str)) << str;
+        if (str.size() == strlen(str.c_str()))
+        {
+            EXPECT_EQ(h, hasher(str.c_str())) << str;
+        }
+
+        // the same chars held in a bigger tier hash the same
+        SString8 onHeap;
+        onHeap.reserve(1000);
+        onHeap.append(str);
+        EXPECT_EQ(h, hasher(onHeap)) << str;
+
+        for (const auto& other : strs)
+        {
+            if (other != str)
+            {
+                EXPECT_NE(h, hasher(other)) << str << " " << other;
+            }
+        }
+    }
+
+    std::unordered_set<SString8, SString8Hash, SString8Equal> set;
+    for (const auto& str : strs)
+        set.insert(SString8(str));
+    EXPECT_EQ(set.size(), strs.size());
+    for (const auto& str : strs)
+    {
+        EXPECT_TRUE(set.find(std::string_view(str)) != set.end()) << str;
+        EXPECT_TRUE(set.find(str) != set.end()) << str;
+        EXPECT_TRUE(set.find(SString8(str)) != set.end()) << str;
+    }
+    EXPECT_TRUE(set.find("abcdef") == set.end());
+    EXPECT_TRUE(set.find("abcdefghijklmno") == set.end());
+
+    const SString8Equal equal;
+    EXPECT_TRUE(equal(SString8("abc"), "abc"));
+    EXPECT_TRUE(equal("abc", SString8("abc")));
+    EXPECT_FALSE(equal(SString8("abc"), std::string_view("abcd")));
+    EXPECT_FALSE(equal(std::string("abcdefghij"), SString8("abcdefghik")));
+
+    // and the same for the other allocators
+    std::unordered_set<PmrSString8, SString8Hash, SString8Equal> pmrSet;
+    std::unordered_set<SlabSString8, SString8Hash, SString8Equal> slabSet;
+    for (const auto& str : strs)
+    {
+        pmrSet.insert(PmrSString8(str));
+        slabSet.insert(SlabSString8(str));
+    }
+    for (const auto& str : strs)
+    {
+        EXPECT_TRUE(pmrSet.find(std::string_view(str)) != pmrSet.end()) << str;
+        EXPECT_TRUE(slabSet.find(std::string_view(str)) != slabSet.end()) << str;
+        EXPECT_TRUE(slabSet.find(SlabSString8(str)) != slabSet.end()) << str;
+    }
+    EXPECT_TRUE(pmrSet.find("abcdefghijklmno") == pmrSet.end());
+    EXPECT_TRUE(equal(PmrSString8("abc"), "abc"));
+    EXPECT_FALSE(equal("abcd", SlabSString8("abc")));
+}
+
+namespace
+{
+    /** Counts what is allocated from it and freed to it, passing everything on to the default resource */
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        size_t m_Allocations = 0;
+        size_t m_Deallocations = 0;
+        size_t m_LiveBytes = 0;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++m_Allocations;
+            m_LiveBytes += bytes;
+            return std::pmr::get_default_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            ++m_Deallocations;
+            m_LiveBytes -= bytes;
+            std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+}
+
+TEST(SString8TestPmr)
+{
+    static_assert(sizeof(PmrSString8) == 8);
+    CountingResource resource;
+    {
+        SString8ResourceScope scope(&resource);
+        const PmrSString8 buffer("abc");
+        EXPECT_EQ(resource.m_Allocations, 0U);
+        for (const auto len : { 8U, 254U, 255U, 32767U, 32768U })
+        {
+            const auto before = resource.m_Allocations;
+            const std::string text(len, 'p');
+            PmrSString8 str(text);
+            EXPECT_EQ(resource.m_Allocations, before + 1) << len;
+            EXPECT_TRUE(std::string_view(str) == text) << len;
+            const auto copy = str;
+            EXPECT_TRUE(copy == str) << len;
+            str.append(100, 'q');
+            str.reserve(100000);
+            EXPECT_EQ(str.size(), len + 100U);
+            EXPECT_EQ(SString8Hash()(copy), SString8Hash()(SString8(text))) << len;
+        }
+        EXPECT_EQ(resource.m_Allocations, resource.m_Deallocations);
+        EXPECT_EQ(resource.m_LiveBytes, 0U);
+    }
+
+    // freed to the resource it came from, even once that resource is no longer current
+    PmrSString8 outlives;
+    CountingResource inner;
+    {
+        SString8ResourceScope scope(&resource);
+        {
+            SString8ResourceScope innerScope(&inner);
+            outlives = PmrSString8(std::string(50, 'i'));
+        }
+        PmrSString8 outer(std::string(50, 'o'));
+        EXPECT_EQ(inner.m_Allocations, 1U);
+        // 50 chars and the null terminator, plus the resource pointer in front
+        EXPECT_EQ(resource.m_LiveBytes, 59U);
+    }
+    EXPECT_EQ(resource.m_LiveBytes, 0U);
+    EXPECT_EQ(inner.m_LiveBytes, 59U);
+    outlives = PmrSString8();
+    EXPECT_EQ(inner.m_Deallocations, 1U);
+    EXPECT_EQ(inner.m_LiveBytes, 0U);
+
+    // a monotonic arena: nothing is freed back to the upstream resource until it is released
+    CountingResource upstream;
+    {
+        std::pmr::monotonic_buffer_resource arena(&upstream);
+        SString8ResourceScope scope(&arena);
+        std::vector<PmrSString8> strs;
+        for (size_t i = 0; i < 1000; ++i)
+            strs.emplace_back(std::string(20 + i % 300, 'a'));
+        EXPECT_TRUE(upstream.m_Allocations > 0U);
+        EXPECT_TRUE(upstream.m_Allocations < 100U);
+        strs.clear();
+        EXPECT_EQ(upstream.m_Deallocations, 0U);
+    }
+    EXPECT_EQ(upstream.m_LiveBytes, 0U);
+}
+
+TEST(SString8TestBorrow)
+{
+    // eg a memory mapped file of null terminated keys
+    const std::string file = std::string("short") + '\0' + std::string(20, 'k') + '\0' + std::string(300, 'm') + '\0' + std::string(9000, 'h') + '\0';
+    const std::string_view shortKey(file.data(), 5);
+    const std::string_view key(file.data() + 6, 20);
+    const std::string_view mediumKey(file.data() + 27, 300);
+    const std::string_view hugeKey(file.data() + 328, 9000);
+
+    CountingResource resource;
+    SString8ResourceScope scope(&resource);
+    {
+        const auto str = PmrSString8::borrow(key);
+        EXPECT_TRUE(str.isBorrowed());
+        EXPECT_EQ(str.data(), key.data());
+        EXPECT_EQ(str.size(), 20U);
+        EXPECT_TRUE(std::string_view(str) == key);
+        EXPECT_EQ(str.compare(key), 0);
+        EXPECT_EQ(SString8Hash()(str), SString8Hash()(key));
+
+        // copies share the chars
+        auto copy = str;
+        EXPECT_TRUE(copy.isBorrowed());
+        EXPECT_EQ(std::as_const(copy).data(), key.data());
+        PmrSString8 assigned;
+        assigned = copy;
+        EXPECT_EQ(std::as_const(assigned).data(), key.data());
+
+        const auto medium = PmrSString8::borrow(mediumKey);
+        EXPECT_TRUE(medium.isBorrowed());
+        EXPECT_TRUE(std::string_view(medium) == mediumKey);
+
+        // too short to be worth it, or too long to fit in the word: copied
+        const auto shortStr = PmrSString8::borrow(shortKey);
+        EXPECT_FALSE(shortStr.isBorrowed());
+        EXPECT_TRUE(std::string_view(shortStr) == shortKey);
+        EXPECT_EQ(resource.m_Allocations, 0U);
+        const auto huge = PmrSString8::borrow(hugeKey);
+        EXPECT_FALSE(huge.isBorrowed());
+        EXPECT_TRUE(std::string_view(huge) == hugeKey);
+        EXPECT_EQ(resource.m_Allocations, 1U);
+    }
+    EXPECT_EQ(resource.m_Deallocations, 1U);
+
+    // every change copies the chars first, leaving the originals alone
+    auto appended = SString8::borrow(key);
+    appended += 'x';
+    EXPECT_FALSE(appended.isBorrowed());
+    EXPECT_TRUE(std::string_view(appended) == std::string(20, 'k') + 'x');
+
+    auto inserted = SString8::borrow(key);
+    inserted.insert(0, "ab");
+    EXPECT_TRUE(std::string_view(inserted) == "ab" + std::string(20, 'k'));
+
+    auto written = SString8::borrow(key);
+    written.data()[0] = 'w';
+    EXPECT_FALSE(written.isBorrowed());
+    EXPECT_TRUE(std::string_view(written) == 'w' + std::string(19, 'k'));
+
+    auto shorter = SString8::borrow(key);
+    shorter = "12345678";
+    EXPECT_TRUE(std::string_view(shorter) == "12345678");
+    shorter = SString8::borrow(key);
+    shorter = 'c';
+    EXPECT_TRUE(std::string_view(shorter) == "c");
+    shorter = SString8::borrow(key);
+    shorter = { 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i' };
+    EXPECT_TRUE(std::string_view(shorter) == "abcdefghi");
+
+    auto reserved = SString8::borrow(key);
+    reserved.reserve(100);
+    EXPECT_FALSE(reserved.isBorrowed());
+    EXPECT_TRUE(std::string_view(reserved) == key);
+
+    EXPECT_TRUE(std::string_view(file.data() + 6, 20) == std::string(20, 'k'));
+}
+
+TEST(SString8TestSharedPayload)
+{
+    constexpr bool shared = SString8Detail::SString8Data::shared_payload;
+    for (const auto len : { 20U, 300U, 40000U })
+    {
+        const std::string text(len, 'p');
+        const SString8 original(text);
+        SString8 copy = original;
+        SString8 assigned;
+        assigned = copy;
+        // only medium and large allocations are shared
+        const auto expectShared = shared && len > 254;
+        EXPECT_EQ(std::as_const(copy).data() == original.data(), expectShared) << len;
+        EXPECT_EQ(std::as_const(assigned).data() == original.data(), expectShared) << len;
+
+        // every change detaches the changed string only
+        copy += 'x';
+        EXPECT_TRUE(std::string_view(copy) == text + 'x') << len;
+        EXPECT_TRUE(std::string_view(original) == text) << len;
+        EXPECT_TRUE(std::string_view(assigned) == text) << len;
+
+        copy = assigned;
+        copy.data()[0] = 'w';
+        EXPECT_TRUE(copy.data()[0] == 'w') << len;
+        EXPECT_TRUE(std::string_view(original) == text) << len;
+        EXPECT_TRUE(std::string_view(assigned) == text) << len;
+
+        copy = assigned;
+        copy.insert(0, "i");
+        copy = assigned;
+        copy = "assigned chars";
+        EXPECT_TRUE(std::string_view(copy) == "assigned chars") << len;
+        copy = assigned;
+        copy = 'c';
+        EXPECT_TRUE(std::string_view(copy) == "c") << len;
+        copy = assigned;
+        copy.reserve(len * 2);
+        EXPECT_TRUE(std::string_view(copy) == text) << len;
+        EXPECT_TRUE(std::string_view(original) == text) << len;
+        EXPECT_TRUE(std::string_view(assigned) == text) << len;
+    }
+
+    // copies made and destroyed on several threads at once
+    const SString8 payload(std::string(1000, 't'));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&payload]()
+            {
+                std::vector<SString8> copies;
+                for (size_t i = 0; i < 10000; ++i)
+                {
+                    copies.push_back(payload);
+                    if (copies.size() == 64)
+                        copies.clear();
+                }
+                for (auto& copy : copies)
+                    copy += 'x';
+            });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    EXPECT_TRUE(std::string_view(payload) == std::string(1000, 't'));
+}
+
+TEST(SString8TestAssign)
+{
+    const std::string text = "abcdefghijklmnopqrstuvwxyz";
+    for (const auto len : { 0U, 5U, 7U, 8U, 26U })
+    {
+        const std::string expected = text.substr(0, len);
+        for (const auto& initial : { std::string(), std::string("xyz"), std::string(300, 'i') })
+        {
+            SString8 str(initial);
+            EXPECT_TRUE(std::string_view(str.assign(text.data(), len)) == expected) << len;
+            str = initial;
+            EXPECT_TRUE(std::string_view(str.assign(expected.c_str())) == expected) << len;
+            str = initial;
+            EXPECT_TRUE(std::string_view(str.assign(SString8(expected))) == expected) << len;
+            str = initial;
+            EXPECT_TRUE(std::string_view(str.assign(SString8(text), 0, len)) == expected) << len;
+            str = initial;
+            EXPECT_TRUE(std::string_view(str.assign(std::string_view(text), 0, len)) == expected) << len;
+            str = initial;
+            EXPECT_TRUE(std::string_view(str.assign(std::string_view(expected))) == expected) << len;
+            str = initial;
+            EXPECT_TRUE(std::string_view(str.assign(len, 'c')) == std::string(len, 'c')) << len;
+            str = initial;
+            EXPECT_TRUE(std::string_view(str.assign(expected.begin(), expected.end())) == expected) << len;
+            str = initial;
+            std::istringstream is(expected);
+            EXPECT_TRUE(std::string_view(str.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>())) == expected) << len;
+        }
+    }
+    SString8 str("initial");
+    EXPECT_TRUE(std::string_view(str.assign({ 'a', 'b', 'c' })) == "abc");
+    bool thrown = false;
+    try
+    {
+        str.assign(SString8("abc"), 4);
+    }
+    catch (std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    // from a part of itself
+    SString8 self(text);
+    self.assign(self.data() + 2, 10);
+    EXPECT_TRUE(std::string_view(self) == text.substr(2, 10));
+    self = text;
+    self.assign(std::as_const(self), 20);
+    EXPECT_TRUE(std::string_view(self) == text.substr(20));
+}
+
+TEST(SString8TestAssignShort)
+{
+    // 7 chars or fewer are written as a whole word, whose bytes after the chars are all zero: up to the size byte of a buffer string, or all 8 of a heap string
+    const auto zeroAfter = [](const SString8& str)
+        {
+            const auto pData = str.data();
+            const size_t end = SString8Detail::SString8Access::storage(str).isBuffer() ? 7U : 8U;
+            for (size_t i = str.size(); i < end; ++i)
+            {
+                if (pData[i] != '\0')
+                    return false;
+            }
+            return true;
+        };
+    const std::string text = "abcdefg";
+
+    // heap: stays in its allocation, over the chars that were there
+    SString8 heap(std::string(300, 'h'));
+    const auto pHeapData = heap.data();
+    const auto heapCapacity = heap.capacity();
+    for (const auto len : { 7U, 3U, 0U, 5U })
+    {
+        heap.assign(text.data(), len);
+        EXPECT_EQ(heap.data(), pHeapData) << len;
+        EXPECT_EQ(heap.capacity(), heapCapacity) << len;
+        EXPECT_TRUE(std::string_view(heap) == text.substr(0, len)) << len;
+        EXPECT_TRUE(zeroAfter(heap)) << len;
+    }
+    // from a part of itself
+    heap = "abcdefghij";
+    heap.assign(heap.data() + 3, 4);
+    EXPECT_TRUE(std::string_view(heap) == "defg");
+    EXPECT_TRUE(zeroAfter(heap));
+
+    // buffer: longer then shorter, over chars that were there
+    SString8 buffer("1234567");
+    for (const auto len : { 2U, 7U, 0U, 6U })
+    {
+        buffer.assign(text.data(), len);
+        EXPECT_TRUE(SString8Detail::SString8Access::storage(buffer).isBuffer()) << len;
+        EXPECT_TRUE(std::string_view(buffer) == text.substr(0, len)) << len;
+        EXPECT_TRUE(zeroAfter(buffer)) << len;
+    }
+    buffer.assign(buffer.data() + 1, 3);
+    EXPECT_TRUE(std::string_view(buffer) == "bcd");
+    EXPECT_TRUE(zeroAfter(buffer));
+
+    // borrowed: its chars can't be written to, so it becomes a string of its own, leaving them alone
+    const std::string file = std::string(20, 'k') + '\0';
+    auto borrowed = SString8::borrow(std::string_view(file.data(), 20));
+    EXPECT_TRUE(borrowed.isBorrowed());
+    borrowed.assign(text.data(), 4);
+    EXPECT_FALSE(borrowed.isBorrowed());
+    EXPECT_TRUE(std::string_view(borrowed) == "abcd");
+    EXPECT_TRUE(zeroAfter(borrowed));
+    EXPECT_TRUE(file == std::string(20, 'k') + '\0');
+}
+
+TEST(SString8TestAssignReuse)
+{
+    CountingResource resource;
+    SString8ResourceScope scope(&resource);
+    const std::vector<std::string> texts = { "short", std::string(20, 'a'), std::string(100, 'b'), "", std::string(250, 'c') };
+    const std::vector<PmrSString8> strs(texts.begin(), texts.end());
+    const auto allocations = resource.m_Allocations;
+
+    // once the capacity is there, none of these allocate
+    PmrSString8 reused;
+    reused.reserve(254);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const auto& text = texts[i % texts.size()];
+        reused = text;
+        EXPECT_TRUE(std::string_view(reused) == text);
+        reused = std::string_view(text);
+        EXPECT_TRUE(std::string_view(reused) == text);
+        reused = strs[i % strs.size()];
+        EXPECT_TRUE(std::string_view(reused) == text);
+        reused = text.c_str();
+        EXPECT_TRUE(std::string_view(reused) == text);
+        reused.assign(text.data(), text.size());
+        EXPECT_TRUE(std::string_view(reused) == text);
+        reused.assign(text.begin(), text.end());
+        EXPECT_TRUE(std::string_view(reused) == text);
+        EXPECT_EQ(reused.capacity(), 254U);
+    }
+    EXPECT_EQ(resource.m_Allocations, allocations + 1U);
+
+    // and without reserving, the capacity is only grown as needed
+    PmrSString8 grown;
+    for (const auto& text : texts)
+        grown = text;
+    EXPECT_EQ(resource.m_Allocations, allocations + 4U);
+}
+
+TEST(SString8TestConstructorRangeAllocations)
+{
+    CountingResource resource;
+    SString8ResourceScope scope(&resource);
+    const std::string text(300, 'f');
+
+    // a forward range is allocated once, with just the capacity needed
+    const PmrSString8 forward(text.begin(), text.end());
+    EXPECT_EQ(resource.m_Allocations, 1U);
+    EXPECT_EQ(forward.capacity(), 300U);
+    const PmrSString8 viewLike(StringViewLike(text), 10, 100);
+    EXPECT_EQ(resource.m_Allocations, 2U);
+    EXPECT_EQ(viewLike.capacity(), 100U);
+    const PmrSString8 shortRange(text.begin(), text.begin() + 7);
+    EXPECT_EQ(resource.m_Allocations, 2U);
+
+    // a single pass range starts in the buffer and then doubles
+    std::istringstream is(text);
+    const PmrSString8 input(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>{});
+    EXPECT_TRUE(std::string_view(input) == text);
+    // 14, 30, 62, 126, 254 and then a medium capacity
+    EXPECT_EQ(resource.m_Allocations - 2U, 6U);
+    EXPECT_EQ(resource.m_Deallocations, 5U);
+}
+
+TEST(SString8TestShrinkToFit)
+{
+    CountingResource resource;
+    SString8ResourceScope scope(&resource);
+    {
+        // a cache value that gets shorter over time
+        PmrSString8 value(std::string(40000, 'v'));
+        value = std::string(300, 'v');
+        EXPECT_EQ(value.capacity(), 40000U);
+        value.shrink_to_fit();
+        EXPECT_EQ(value.capacity(), 300U);
+        // the capacity header and the chars, plus the resource pointer in front
+        EXPECT_EQ(resource.m_LiveBytes, SString8Detail::SString8Data::allocationSize(300) + 8U);
+        value = std::string(100, 'v');
+        value.shrink_to_fit();
+        EXPECT_EQ(value.capacity(), 100U);
+        EXPECT_EQ(resource.m_LiveBytes, SString8Detail::SString8Data::allocationSize(100) + 8U);
+        value = "abc";
+        value.shrink_to_fit();
+        EXPECT_EQ(value.capacity(), 7U);
+        EXPECT_EQ(resource.m_LiveBytes, 0U);
+        EXPECT_TRUE(value == PmrSString8("abc"));
+        // already as small as it gets
+        const auto allocations = resource.m_Allocations;
+        value.shrink_to_fit();
+        value = std::string(20, 'v');
+        value.shrink_to_fit();
+        EXPECT_EQ(resource.m_Allocations, allocations + 1U);
+    }
+    EXPECT_EQ(resource.m_LiveBytes, 0U);
+
+    // a borrowed string has nothing to shrink
+    const std::string text(50, 'b');
+    auto borrowed = SString8::borrow(text);
+    borrowed.shrink_to_fit();
+    EXPECT_TRUE(borrowed.isBorrowed());
+}
+
+TEST(SString8TestClear)
+{
+    CountingResource resource;
+    SString8ResourceScope scope(&resource);
+    PmrSString8 str(std::string(1000, 'c'));
+    str.clear();
+    EXPECT_TRUE(str.size() == 0U);
+    EXPECT_TRUE(std::string_view(str).empty());
+    EXPECT_EQ(str.capacity(), 1000U);
+    EXPECT_EQ(resource.m_Deallocations, 0U);
+    str = std::string(500, 'd');
+    EXPECT_EQ(resource.m_Allocations, 1U);
+    str.clear(true);
+    EXPECT_EQ(str.capacity(), 7U);
+    EXPECT_EQ(resource.m_LiveBytes, 0U);
+    EXPECT_TRUE(str == PmrSString8());
+
+    const std::string text(50, 'b');
+    auto borrowed = SString8::borrow(text);
+    borrowed.clear();
+    EXPECT_FALSE(borrowed.isBorrowed());
+    EXPECT_EQ(borrowed.size(), 0U);
+    EXPECT_EQ(text, std::string(50, 'b'));
+}
+
+namespace
+{
+    // a keyword table, constant initialised, so built at compile time rather than during static initialisation
+    constexpr SString8 keywords[] = { "GET"_s8, "PUT"_s8, "POST"_s8, "DELETE"_s8, ""_s8, "7 chars"_s8 };
+    constinit const SString8 constinitKey("HEAD");
+
+    static_assert(keywords[0].size() == 3);
+    static_assert(keywords[3].length() == 6);
+    static_assert(keywords[4].size() == 0);
+    static_assert(keywords[5].size() == 7);
+    static_assert(keywords[0] == SString8("GET"));
+    static_assert(keywords[0] != keywords[1]);
+    static_assert(keywords[2] < keywords[1]);
+    static_assert((keywords[4] <=> keywords[0]) == std::strong_ordering::less);
+    static_assert(keywords[3].compare(SString8("DELETE")) == 0);
+    static_assert(SString8(std::string_view("abc")) == "abc"_s8);
+    static_assert("a\0b"_s8.size() == 3);
+    // "8 chars!"_s8 does not compile, and nor does constexpr SString8("8 chars!")
+}
+
+TEST(SString8TestConstexpr)
+{
+    // the same words as made at run time
+    const std::vector<std::string> texts = { "GET", "PUT", "POST", "DELETE", "", "7 chars" };
+    for (size_t i = 0; i < texts.size(); ++i)
+    {
+        const SString8 runtime(texts[i]);
+        EXPECT_TRUE(keywords[i] == runtime) << i;
+        EXPECT_TRUE(std::string_view(keywords[i]) == texts[i]) << i;
+        EXPECT_EQ(SString8Hash()(keywords[i]), SString8Hash()(runtime)) << i;
+        EXPECT_EQ(keywords[i].capacity(), 7U) << i;
+    }
+    EXPECT_TRUE(std::string_view(constinitKey) == "HEAD");
+    auto copy = keywords[3];
+    copy += "_ALL";
+    EXPECT_TRUE(std::string_view(copy) == "DELETE_ALL");
+}
+
+namespace
+{
+    /** The strings to search, as each SString8 tier holds them: in the buffer, on the heap (even when short), borrowed, and medium */
+    std::vector<std::pair<std::string, SString8>> searchTargets()
+    {
+        using namespace std::string_literals;
+        static const std::string longText = std::string(250, 'x') + "a,b;c d" + std::string(50, 'y') + "abcab";
+        // static, as the borrowed strings refer to them
+        static const std::vector<std::string> texts{ ""s, "a"s, "ab"s, "a\0b"s, "abcab"s, "abcdefg"s, "aaaaaaa"s, "abcdefgh"s, "x,y;z a,b;c"s, "abcabcabcabcabcabcabcabcabcabcabcabcab"s, longText };
+        std::vector<std::pair<std::string, SString8>> targets;
+        for (const auto& text : texts)
+        {
+            targets.emplace_back(text, SString8(text));
+            SString8 heap;
+            heap.reserve(100);
+            heap.append(text);
+            targets.emplace_back(text, heap);
+            if (text.size() > 7)
+                targets.emplace_back(text, SString8::borrow(text));
+        }
+        // the buffer after a longer string was in it
+        SString8 reused("abcdefg");
+        reused = "ab";
+        targets.emplace_back("ab", reused);
+        return targets;
+    }
+
+    /** Check that search gives the same for std::string and SString8, for every target, needle and position */
+    template<class Search>
+    void testSearch(Search&& search, int line)
+    {
+        using namespace std::string_literals;
+        const std::vector<std::string> needles{ ""s, "a"s, "b"s, "\0"s, "z"s, "ab"s, "ca"s, "abc"s, "a\0b"s, ",; "s, "abcdefg"s, "abcdefgh"s, "bca"s, "xyz,;ab"s, "abcdefghijklmnopqrstuvwxyz"s };
+        for (const auto& [text, s8] : searchTargets())
+        {
+            for (const auto& needle : needles)
+            {
+                for (size_t pos = 0; pos <= text.size() + 2; pos += (pos < 20 || pos + 20 > text.size()) ? 1 : 7)
+                    EXPECT_EQ(search(text, needle, pos), search(s8, needle, pos)) << line << " " << text << " " << needle << " " << pos;
+                EXPECT_EQ(search(text, needle, std::string::npos), search(s8, needle, SString8::npos)) << line << " " << text << " " << needle;
+            }
+        }
+    }
+}
+
+TEST(SString8TestFind)
+{
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.find(needle.data(), pos, needle.size()); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.find(std::string_view(needle), pos); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.find(needle.c_str(), pos); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return needle.empty() ? 0 : str.find(needle[0], pos); }, __LINE__);
+    const SString8 s8("one two");
+    EXPECT_EQ(s8.find(SString8("two")), 4U);
+    EXPECT_EQ(s8.find("o"), 0U);
+    EXPECT_EQ(s8.find("o", 1), 6U);
+    EXPECT_EQ(s8.find('x'), SString8::npos);
+}
+
+TEST(SString8TestRfind)
+{
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.rfind(needle.data(), pos, needle.size()); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.rfind(needle.c_str(), pos); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return needle.empty() ? 0 : str.rfind(needle[0], pos); }, __LINE__);
+    const SString8 s8("one two one");
+    EXPECT_EQ(s8.rfind(SString8("one")), 8U);
+    EXPECT_EQ(s8.rfind("one", 7), 0U);
+    EXPECT_EQ(s8.rfind('o'), 8U);
+}
+
+TEST(SString8TestFindFirstOf)
+{
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.find_first_of(needle.data(), pos, needle.size()); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.find_first_of(std::string_view(needle), pos); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return needle.empty() ? 0 : str.find_first_of(needle[0], pos); }, __LINE__);
+    EXPECT_EQ(SString8("key=value").find_first_of(SString8("=:")), 3U);
+}
+
+TEST(SString8TestFindFirstNotOf)
+{
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.find_first_not_of(needle.data(), pos, needle.size()); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.find_first_not_of(needle.c_str(), pos); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return needle.empty() ? 0 : str.find_first_not_of(needle[0], pos); }, __LINE__);
+    EXPECT_EQ(SString8("   indented text").find_first_not_of(' '), 3U);
+}
+
+TEST(SString8TestFindLastOf)
+{
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.find_last_of(needle.data(), pos, needle.size()); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.find_last_of(std::string_view(needle), pos); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return needle.empty() ? 0 : str.find_last_of(needle[0], pos); }, __LINE__);
+    EXPECT_EQ(SString8("dir/sub/file.txt").find_last_of("/\\"), 7U);
+}
+
+TEST(SString8TestFindLastNotOf)
+{
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.find_last_not_of(needle.data(), pos, needle.size()); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return str.find_last_not_of(needle.c_str(), pos); }, __LINE__);
+    testSearch([](const auto& str, const std::string& needle, size_t pos) { return needle.empty() ? 0 : str.find_last_not_of(needle[0], pos); }, __LINE__);
+    EXPECT_EQ(SString8("trailing spaces   ").find_last_not_of(' '), 14U);
+}
+
+TEST(SString8TestContains)
+{
+    // std::string::contains is C++23
+    testSearch([](const auto& str, const std::string& needle, size_t)
+        {
+            if constexpr (std::is_same_v<std::decay_t<decltype(str)>, std::string>)
+                return str.find(needle) != std::string::npos;
+            else
+                return str.contains(std::string_view(needle));
+        }, __LINE__);
+    for (const auto& [text, s8] : searchTargets())
+    {
+        EXPECT_EQ(text.find("ab") != std::string::npos, s8.contains("ab")) << text;
+        EXPECT_EQ(text.find(std::string_view("a\0b", 3)) != std::string::npos, s8.contains(std::string_view("a\0b", 3))) << text;
+        EXPECT_EQ(text.find(',') != std::string::npos, s8.contains(',')) << text;
+        EXPECT_EQ(text.find('\0') != std::string::npos, s8.contains('\0')) << text;
+    }
+}
+
+TEST(SString8TestGetline)
+{
+    // the same lines and stream states as std::getline, including a line longer than a chunk and the last line without a newline
+    const std::string text = "short\n\nexactly8\r\n" + std::string(300, 'x') + "\n" + std::string(127, 'y') + "\n" + std::string(128, 'z') + std::string("\na\0b\nlast", 9);
+    std::istringstream expectedStream(text);
+    std::istringstream stream(text);
+    std::string expected;
+    SString8 line;
+    for (;;)
+    {
+        const bool expectedGood = static_cast<bool>(std::getline(expectedStream, expected));
+        const bool good = static_cast<bool>(getline(stream, line));
+        EXPECT_EQ(good, expectedGood);
+        EXPECT_EQ(stream.eof(), expectedStream.eof());
+        if (!good || !expectedGood)
+            break;
+        EXPECT_EQ(std::string_view(line), expected);
+    }
+    EXPECT_TRUE(stream.fail());
+
+    // a heap string keeps its allocation for shorter lines
+    std::istringstream csv("a,b;c");
+    SString8 field;
+    field.reserve(100);
+    const auto pData = field.data();
+    EXPECT_TRUE(static_cast<bool>(getline(csv, field, ',')));
+    EXPECT_EQ(field, "a");
+    EXPECT_EQ(field.data(), pData);
+    EXPECT_TRUE(static_cast<bool>(getline(csv, field, ';')));
+    EXPECT_EQ(field, "b");
+    EXPECT_TRUE(static_cast<bool>(getline(csv, field, ';')));
+    EXPECT_EQ(field, "c");
+    EXPECT_TRUE(csv.eof());
+    EXPECT_FALSE(csv.fail());
+
+    // an empty line is a success, but nothing to read is not
+    std::istringstream empty("\n");
+    EXPECT_TRUE(static_cast<bool>(getline(empty, line)));
+    EXPECT_TRUE(line.size() == 0);
+    EXPECT_FALSE(static_cast<bool>(getline(empty, line)));
+
+    // a line longer than a chunk doesn't throw from a stream that throws on failbit, but nothing to read does
+    std::istringstream throwing(std::string(254, 't'));
+    throwing.exceptions(std::ios_base::failbit);
+    EXPECT_TRUE(static_cast<bool>(getline(throwing, line)));
+    EXPECT_EQ(line.size(), 254U);
+    bool threw = false;
+    try
+    {
+        getline(throwing, line);
+    }
+    catch (const std::ios_base::failure&)
+    {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+TEST(SString8TestOperatorGtGt)
+{
+    const std::string text = "  one\ttwo\n\n three " + std::string(200, 'w') + " seven77 eight888";
+    std::istringstream expectedStream(text);
+    std::istringstream stream(text);
+    std::string expected;
+    SString8 word;
+    for (;;)
+    {
+        const bool expectedGood = static_cast<bool>(expectedStream >> expected);
+        const bool good = static_cast<bool>(stream >> word);
+        EXPECT_EQ(good, expectedGood);
+        EXPECT_EQ(stream.eof(), expectedStream.eof());
+        if (!good || !expectedGood)
+            break;
+        EXPECT_EQ(std::string_view(word), expected);
+    }
+
+    // the width limits one read, and is then reset
+    std::istringstream widths("abcdefghij klm");
+    widths >> std::setw(4) >> word;
+    EXPECT_EQ(word, "abcd");
+    EXPECT_EQ(widths.width(), 0);
+    widths >> word;
+    EXPECT_EQ(word, "efghij");
+
+    std::istringstream numbers("12 34");
+    int number = 0;
+    numbers >> word >> number;
+    EXPECT_EQ(word, "12");
+    EXPECT_EQ(number, 34);
+}
+
+TEST(SString8TestOperatorLtLt)
+{
+    // every tier, and embedded nulls, which writing data() as a C string would have stopped at
+    for (const auto& text : std::vector<std::string>{ "", "abc", "exactly8", std::string(300, 'x'), std::string("a\0b", 3), std::string(20, '\0') })
+    {
+        std::ostringstream os;
+        os << SString8(std::string_view(text));
+        EXPECT_EQ(os.str(), text);
+    }
+
+    // padded as std::string
+    std::ostringstream padded;
+    padded << std::setw(6) << SString8("ab") << '|' << std::left << std::setw(4) << SString8("cd") << '|';
+    EXPECT_EQ(padded.str(), "    ab|cd  |");
+}
@@ -0,0 +1,138 @@
+#include "SString8Writer.h"
+
+#include "PintTest.h"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    /** A file to write to, which gives what was written to it once closed */
+    class TempFile
+    {
+    public:
+        TempFile()
+            : m_Path(std::filesystem::temp_directory_path() / "SString8WriterTest.txt")
+        {
+#if defined(_WIN32)
+            m_Handle = CreateFileW(m_Path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+            m_Handle = open(m_Path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+        }
+
+        ~TempFile()
+        {
+            std::filesystem::remove(m_Path);
+        }
+
+        SString8Writer::Handle handle() const { return m_Handle; }
+
+        std::string closeAndRead()
+        {
+#if defined(_WIN32)
+            CloseHandle(m_Handle);
+#else
+            close(m_Handle);
+#endif
+            std::ifstream is(m_Path, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+        }
+
+    private:
+        std::filesystem::path m_Path;
+        SString8Writer::Handle m_Handle;
+    };
+}
+
+TEST(SString8WriterTestWrite)
+{
+    // every tier, either side of copyBelow, more references than a single write takes and more copies than the staging buffer holds
+    std::vector<SString8> strings;
+    for (size_t i = 0; i < 5000; ++i)
+        strings.emplace_back(std::string(i % 300, static_cast<char>('a' + i % 26)));
+    strings.emplace_back(std::string("a\0b", 3));
+
+    for (const size_t copyBelow : { size_t(0), size_t(8), SString8Writer::defaultCopyBelow, size_t(1) << 20U })
+    {
+        std::string expected;
+        TempFile file;
+        {
+            SString8Writer writer(file.handle(), copyBelow);
+            for (const auto& str : strings)
+            {
+                writer.write(str);
+                writer.write(std::string_view("|"));
+                expected += std::string_view(str);
+                expected += '|';
+            }
+            writer.flush();
+            // nothing, with no chars to point to
+            writer.write(std::string_view());
+            // and after a flush, finished by the destructor
+            writer.write(SString8("last"));
+            expected += "last";
+        }
+        EXPECT_TRUE(file.closeAndRead() == expected) << copyBelow;
+    }
+
+    // the error comes from the flush, which drops what was pending
+#if defined(_WIN32)
+    SString8Writer writer(INVALID_HANDLE_VALUE);
+#else
+    SString8Writer writer(-1);
+#endif
+    writer.write(SString8("lost"));
+    bool threw = false;
+    try
+    {
+        writer.flush();
+    }
+    catch (const std::system_error&)
+    {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+    writer.flush();
+}
+
+TEST(SString8WriterTestWriteAll)
+{
+    const std::vector<std::vector<SString8>> rows = { { SString8("id"), SString8("name"), SString8("description") },
+        { SString8("1"), SString8("a"), SString8(std::string_view(std::string(200, 'd'))) },
+        { SString8("2"), SString8(""), SString8("") },
+        {} };
+    std::ostringstream expected;
+    TempFile file;
+    {
+        SString8Writer writer(file.handle());
+        for (const auto& row : rows)
+        {
+            writer.writeAll(row, "\t", "\n");
+            for (size_t i = 0; i < row.size(); ++i)
+                expected << (i == 0 ? "" : "\t") << row[i];
+            expected << '\n';
+        }
+        // other strings, with no separator or terminator, or long ones that are written in place
+        const std::string longSeparator(300, '-');
+        writer.writeAll(std::vector<std::string>{ "x", "y", "z" });
+        writer.writeAll(std::vector<std::string_view>{ "x", "y" }, longSeparator, longSeparator);
+        expected << "xyz" << "x" << longSeparator << "y" << longSeparator;
+        writer.flush();
+    }
+    EXPECT_TRUE(file.closeAndRead() == expected.str());
+}